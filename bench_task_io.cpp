@@ -0,0 +1,86 @@
+// Benchmark for streaming CSV / JSON Lines import and export.
+// Build: g++ -O2 -std=c++17 -pthread bench_task_io.cpp task_io.cpp task_store.cpp -o bench_task_io
+// Usage: ./bench_task_io [records] [directory]
+#include "task_io.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace std;
+
+namespace
+{
+double secondsSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void runImport(const string &path, task_io::Format format, bool use_mmap, double megabytes)
+{
+    task_io::ImportOptions options;
+    options.use_mmap = use_mmap;
+
+    auto start = chrono::steady_clock::now();
+    size_t title_bytes = 0;
+    task_io::ImportResult result = task_io::importFile(path, format, [&](vector<Task> &batch) {
+        for (const auto &task : batch)
+            title_bytes += task.title.size();
+    }, options);
+    double elapsed = secondsSince(start);
+
+    cout << "  import (" << (use_mmap ? "mmap" : "read") << "): " << result.records << " records, "
+         << result.malformed << " malformed, " << elapsed << " s, " << megabytes / elapsed << " MB/s" << endl;
+    if (title_bytes == 0)
+        cout << "  (no data)" << endl;
+}
+}
+
+int main(int argc, char **argv)
+{
+    size_t records = argc > 1 ? strtoul(argv[1], nullptr, 10) : 5000000;
+    string directory = argc > 2 ? argv[2] : "/tmp";
+
+    TaskStore store;
+    mt19937 rng(7);
+    for (size_t i = 0; i < records; ++i)
+    {
+        Task task;
+        task.task_id = static_cast<int>(i + 1);
+        task.title = "Task " + to_string(i) + (i % 7 == 0 ? ", with comma" : "");
+        task.description = "Generated description \"" + to_string(rng()) + "\" for benchmarking";
+        task.priority = static_cast<Priority>(rng() % 3);
+        task.is_completed = rng() % 2 == 0;
+        task.due_date = i % 3 == 0 ? NO_DUE_DATE : 1700000000 + static_cast<long long>(i);
+        store.push_back(move(task));
+    }
+
+    const pair<task_io::Format, const char *> formats[] = {{task_io::Format::CSV, "csv"},
+                                                           {task_io::Format::JSONL, "jsonl"}};
+    for (const auto &format : formats)
+    {
+        string path = directory + "/bench_tasks." + format.second;
+
+        auto start = chrono::steady_clock::now();
+        long long written = task_io::exportFile(store.snapshot(), path, format.first);
+        double elapsed = secondsSince(start);
+
+        FILE *file = fopen(path.c_str(), "rb");
+        if (written < 0 || file == nullptr)
+        {
+            cout << "Error: Cannot write " << path << endl;
+            return 1;
+        }
+        fseek(file, 0, SEEK_END);
+        double megabytes = static_cast<double>(ftell(file)) / (1 << 20);
+        fclose(file);
+
+        cout << format.second << ": " << megabytes << " MB" << endl;
+        cout << "  export: " << written << " records, " << elapsed << " s, " << megabytes / elapsed << " MB/s" << endl;
+        runImport(path, format.first, true, megabytes);
+        runImport(path, format.first, false, megabytes);
+        remove(path.c_str());
+    }
+    return 0;
+}
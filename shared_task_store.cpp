@@ -0,0 +1,591 @@
+#include "shared_task_store.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string_view>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace
+{
+constexpr uint64_t SEGMENT_MAGIC = 0x314d48534b534154;  // "TASKSHM1" in little-endian
+constexpr uint32_t SEGMENT_VERSION = 1;
+constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+constexpr size_t ALIGNMENT = 64;
+
+static_assert(atomic<uint64_t>::is_always_lock_free, "seqlock counter must be lock-free to live in shared memory");
+
+// Geometry fields are written once by create(); count, arena_used and the
+// data behind the offsets change under the sequence counter.
+struct SharedHeader
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t table_size;  // power of two
+    uint32_t count;
+    uint64_t records_offset;
+    uint64_t table_offset;
+    uint64_t arena_offset;
+    uint64_t arena_size;
+    uint64_t arena_used;
+    atomic<uint64_t> sequence;  // odd while the writer is mid-update
+};
+
+struct SharedRecord
+{
+    int32_t task_id;
+    uint8_t priority;
+    uint8_t completed;
+    uint16_t reserved;
+    int64_t due_date;
+    uint64_t title_offset;        // relative to the arena
+    uint64_t description_offset;  // relative to the arena
+    uint32_t title_length;
+    uint32_t description_length;
+};
+
+struct TableEntry
+{
+    int32_t task_id;
+    uint32_t slot;  // index into the records, or EMPTY_SLOT
+};
+
+size_t alignUp(size_t value)
+{
+    return (value + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+uint32_t homeSlot(int task_id, uint32_t table_size)
+{
+    return (static_cast<uint32_t>(task_id) * 2654435761u) & (table_size - 1);
+}
+
+SharedHeader* headerOf(char *base) { return reinterpret_cast<SharedHeader *>(base); }
+const SharedHeader* headerOf(const char *base) { return reinterpret_cast<const SharedHeader *>(base); }
+
+template <typename T>
+T* at(char *base, uint64_t offset) { return reinterpret_cast<T *>(base + offset); }
+template <typename T>
+const T* at(const char *base, uint64_t offset) { return reinterpret_cast<const T *>(base + offset); }
+
+// Probes at most table_size entries so torn reads cannot loop forever.
+// Returns table_size if the id is absent.
+uint32_t findEntry(const TableEntry *table, uint32_t table_size, int task_id)
+{
+    uint32_t mask = table_size - 1;
+    uint32_t i = homeSlot(task_id, table_size);
+    for (uint32_t probes = 0; probes < table_size; ++probes, i = (i + 1) & mask)
+    {
+        if (table[i].slot == EMPTY_SLOT)
+            return table_size;
+        if (table[i].task_id == task_id)
+            return i;
+    }
+    return table_size;
+}
+
+const char* formatPriorityName(Priority priority)
+{
+    switch (priority)
+    {
+    case Priority::LOW:
+        return "Low";
+    case Priority::MEDIUM:
+        return "Medium";
+    case Priority::HIGH:
+        return "High";
+    default:
+        return "Unknown";
+    }
+}
+
+// Reader-side string access; torn offsets yield an empty view, never a fault
+string_view arenaText(const char *arena, uint64_t arena_size, uint64_t offset, uint32_t length)
+{
+    if (offset > arena_size || length > arena_size - offset)
+        return string_view();
+    return string_view(arena + offset, length);
+}
+}
+
+// ---- Writer ----
+
+SharedTaskStore::SharedTaskStore() : base(nullptr), mapped_size(0) {}
+
+SharedTaskStore::~SharedTaskStore()
+{
+    if (base != nullptr)
+    {
+        munmap(base, mapped_size);
+        shm_unlink(name.c_str());
+    }
+}
+
+bool SharedTaskStore::create(const string &segment_name, uint32_t capacity, size_t arena_bytes)
+{
+    uint32_t table_size = 1;
+    while (table_size < 2 * max<uint32_t>(capacity, 1))
+        table_size <<= 1;
+
+    size_t records_offset = alignUp(sizeof(SharedHeader));
+    size_t table_offset = alignUp(records_offset + sizeof(SharedRecord) * capacity);
+    size_t arena_offset = alignUp(table_offset + sizeof(TableEntry) * table_size);
+    size_t total = alignUp(arena_offset + arena_bytes);
+
+    // Replace rather than truncate: readers that still map the old object keep
+    // valid pages instead of faulting with SIGBUS
+    shm_unlink(segment_name.c_str());
+    int fd = shm_open(segment_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        return false;
+    bool sized = ftruncate(fd, static_cast<off_t>(total)) == 0;
+    void *mapped = sized ? mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        shm_unlink(segment_name.c_str());
+        return false;
+    }
+
+    name = segment_name;
+    base = static_cast<char *>(mapped);
+    mapped_size = total;
+
+    SharedHeader *header = new (base) SharedHeader();
+    header->version = SEGMENT_VERSION;
+    header->capacity = capacity;
+    header->table_size = table_size;
+    header->count = 0;
+    header->records_offset = records_offset;
+    header->table_offset = table_offset;
+    header->arena_offset = arena_offset;
+    header->arena_size = arena_bytes;
+    header->arena_used = 0;
+    header->sequence.store(0, memory_order_relaxed);
+    TableEntry *table = at<TableEntry>(base, table_offset);
+    for (uint32_t i = 0; i < table_size; ++i)
+        table[i].slot = EMPTY_SLOT;
+
+    // Readers check the magic last, so they never see a half-built header
+    atomic_thread_fence(memory_order_release);
+    header->magic = SEGMENT_MAGIC;
+    return true;
+}
+
+void SharedTaskStore::beginWrite()
+{
+    atomic<uint64_t> &sequence = headerOf(base)->sequence;
+    sequence.store(sequence.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+void SharedTaskStore::endWrite()
+{
+    atomic<uint64_t> &sequence = headerOf(base)->sequence;
+    sequence.store(sequence.load(memory_order_relaxed) + 1, memory_order_release);
+}
+
+void SharedTaskStore::storeString(const string &text, uint64_t &offset, uint32_t &length)
+{
+    SharedHeader *header = headerOf(base);
+    char *arena = base + header->arena_offset;
+    if (text.size() > length)
+    {
+        offset = header->arena_used;
+        header->arena_used += text.size();
+    }
+    memcpy(arena + offset, text.data(), text.size());
+    length = static_cast<uint32_t>(text.size());
+}
+
+// Rewrites the arena so it holds only strings that records still use
+void SharedTaskStore::compactArena()
+{
+    SharedHeader *header = headerOf(base);
+    SharedRecord *records = at<SharedRecord>(base, header->records_offset);
+    char *arena = base + header->arena_offset;
+
+    string packed;
+    packed.reserve(header->arena_used);
+    for (uint32_t i = 0; i < header->count; ++i)
+    {
+        SharedRecord &record = records[i];
+        uint64_t title_offset = packed.size();
+        packed.append(arena + record.title_offset, record.title_length);
+        uint64_t description_offset = packed.size();
+        packed.append(arena + record.description_offset, record.description_length);
+        record.title_offset = title_offset;
+        record.description_offset = description_offset;
+    }
+    memcpy(arena, packed.data(), packed.size());
+    header->arena_used = packed.size();
+}
+
+bool SharedTaskStore::put(const Task &task)
+{
+    if (base == nullptr)
+        return false;
+
+    SharedHeader *header = headerOf(base);
+    SharedRecord *records = at<SharedRecord>(base, header->records_offset);
+    TableEntry *table = at<TableEntry>(base, header->table_offset);
+
+    uint32_t entry = findEntry(table, header->table_size, task.task_id);
+    bool exists = entry != header->table_size;
+    if (!exists && header->count == header->capacity)
+        return false;
+
+    uint32_t old_title = exists ? records[table[entry].slot].title_length : 0;
+    uint32_t old_description = exists ? records[table[entry].slot].description_length : 0;
+    uint64_t needed = (task.title.size() > old_title ? task.title.size() : 0) +
+                      (task.description.size() > old_description ? task.description.size() : 0);
+    if (header->arena_used + needed > header->arena_size)
+    {
+        beginWrite();
+        compactArena();
+        endWrite();
+        if (header->arena_used + needed > header->arena_size)
+        {
+            // Readers must not keep seeing the version this call replaces
+            if (exists)
+                erase(task.task_id);
+            return false;
+        }
+    }
+
+    beginWrite();
+    uint32_t slot;
+    if (exists)
+    {
+        slot = table[entry].slot;
+    }
+    else
+    {
+        slot = header->count++;
+        records[slot] = SharedRecord();
+        uint32_t mask = header->table_size - 1;
+        uint32_t i = homeSlot(task.task_id, header->table_size);
+        while (table[i].slot != EMPTY_SLOT)
+            i = (i + 1) & mask;
+        table[i].task_id = task.task_id;
+        table[i].slot = slot;
+    }
+
+    SharedRecord &record = records[slot];
+    record.task_id = task.task_id;
+    record.priority = static_cast<uint8_t>(task.priority);
+    record.completed = task.is_completed ? 1 : 0;
+    record.due_date = task.due_date;
+    storeString(task.title, record.title_offset, record.title_length);
+    storeString(task.description, record.description_offset, record.description_length);
+    endWrite();
+    return true;
+}
+
+bool SharedTaskStore::erase(int task_id)
+{
+    if (base == nullptr)
+        return false;
+
+    SharedHeader *header = headerOf(base);
+    SharedRecord *records = at<SharedRecord>(base, header->records_offset);
+    TableEntry *table = at<TableEntry>(base, header->table_offset);
+    uint32_t mask = header->table_size - 1;
+
+    uint32_t entry = findEntry(table, header->table_size, task_id);
+    if (entry == header->table_size)
+        return false;
+
+    beginWrite();
+    // Keep the records dense by moving the last one into the hole
+    uint32_t slot = table[entry].slot;
+    uint32_t last = header->count - 1;
+    if (slot != last)
+    {
+        records[slot] = records[last];
+        table[findEntry(table, header->table_size, records[slot].task_id)].slot = slot;
+    }
+    --header->count;
+
+    // Backward-shift deletion keeps probe chains intact without tombstones
+    uint32_t hole = entry;
+    for (uint32_t next = (hole + 1) & mask; table[next].slot != EMPTY_SLOT; next = (next + 1) & mask)
+    {
+        uint32_t home = homeSlot(table[next].task_id, header->table_size);
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            table[hole] = table[next];
+            hole = next;
+        }
+    }
+    table[hole].slot = EMPTY_SLOT;
+    endWrite();
+    return true;
+}
+
+void SharedTaskStore::clear()
+{
+    if (base == nullptr)
+        return;
+
+    SharedHeader *header = headerOf(base);
+    TableEntry *table = at<TableEntry>(base, header->table_offset);
+    beginWrite();
+    header->count = 0;
+    header->arena_used = 0;
+    for (uint32_t i = 0; i < header->table_size; ++i)
+        table[i].slot = EMPTY_SLOT;
+    endWrite();
+}
+
+uint32_t SharedTaskStore::size() const
+{
+    return base == nullptr ? 0 : headerOf(base)->count;
+}
+
+// ---- Reader ----
+
+SharedTaskReader::SharedTaskReader() : base(nullptr), mapped_size(0) {}
+
+SharedTaskReader::~SharedTaskReader()
+{
+    if (base != nullptr)
+        munmap(const_cast<char *>(base), mapped_size);
+}
+
+bool SharedTaskReader::open(const string &name)
+{
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    void *mapped = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(SharedHeader))
+        mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+        return false;
+
+    const char *segment = static_cast<const char *>(mapped);
+    size_t size = static_cast<size_t>(info.st_size);
+    const SharedHeader *header = headerOf(segment);
+    // The writer stores the magic last; the geometry is only safe to read
+    // after it has been seen
+    bool valid = header->magic == SEGMENT_MAGIC;
+    atomic_thread_fence(memory_order_acquire);
+    valid = valid && header->version == SEGMENT_VERSION &&
+            header->table_size != 0 && (header->table_size & (header->table_size - 1)) == 0 &&
+            header->records_offset + sizeof(SharedRecord) * header->capacity <= size &&
+            header->table_offset + sizeof(TableEntry) * header->table_size <= size &&
+            header->arena_offset + header->arena_size <= size;
+    if (!valid)
+    {
+        munmap(mapped, size);
+        return false;
+    }
+
+    if (base != nullptr)
+        munmap(const_cast<char *>(base), mapped_size);
+    base = segment;
+    mapped_size = size;
+    return true;
+}
+
+// Runs fn until it completes without the writer touching the segment. fn
+// must tolerate torn data (it is discarded) and must not have side effects
+// beyond its own outputs, which it should reset on entry.
+template <typename Function>
+void SharedTaskReader::readConsistent(Function fn) const
+{
+    const SharedHeader *header = headerOf(base);
+    for (;;)
+    {
+        uint64_t before = header->sequence.load(memory_order_acquire);
+        if (before & 1)
+        {
+            this_thread::yield();
+            continue;
+        }
+        fn(header);
+        atomic_thread_fence(memory_order_acquire);
+        if (header->sequence.load(memory_order_relaxed) == before)
+            return;
+    }
+}
+
+namespace
+{
+// Copies one record out of the segment; bounds-checked against torn data
+void copyRecord(const char *base, const SharedHeader *header, const SharedRecord &record, Task &task)
+{
+    const char *arena = base + header->arena_offset;
+    task.task_id = record.task_id;
+    task.priority = static_cast<Priority>(min<uint8_t>(record.priority, static_cast<uint8_t>(Priority::HIGH)));
+    task.is_completed = record.completed != 0;
+    task.due_date = record.due_date;
+    task.title.assign(arenaText(arena, header->arena_size, record.title_offset, record.title_length));
+    task.description.assign(arenaText(arena, header->arena_size, record.description_offset, record.description_length));
+}
+
+uint32_t liveCount(const SharedHeader *header)
+{
+    return min(header->count, header->capacity);
+}
+}
+
+int SharedTaskReader::getTaskCount() const
+{
+    if (base == nullptr)
+        return 0;
+    uint32_t count = 0;
+    readConsistent([&](const SharedHeader *header) { count = liveCount(header); });
+    return static_cast<int>(count);
+}
+
+bool SharedTaskReader::findTask(int task_id, Task &task) const
+{
+    if (base == nullptr)
+        return false;
+
+    bool found = false;
+    readConsistent([&](const SharedHeader *header) {
+        const TableEntry *table = at<TableEntry>(base, header->table_offset);
+        const SharedRecord *records = at<SharedRecord>(base, header->records_offset);
+        uint32_t entry = findEntry(table, header->table_size, task_id);
+        found = entry != header->table_size && table[entry].slot < liveCount(header) &&
+                records[table[entry].slot].task_id == task_id;
+        if (found)
+            copyRecord(base, header, records[table[entry].slot], task);
+    });
+    return found;
+}
+
+vector<Task> SharedTaskReader::getAllTasks() const
+{
+    vector<Task> tasks;
+    if (base == nullptr)
+        return tasks;
+
+    readConsistent([&](const SharedHeader *header) {
+        const SharedRecord *records = at<SharedRecord>(base, header->records_offset);
+        uint32_t count = liveCount(header);
+        tasks.resize(count);
+        for (uint32_t i = 0; i < count; ++i)
+            copyRecord(base, header, records[i], tasks[i]);
+    });
+    return tasks;
+}
+
+void SharedTaskReader::displayTaskCount() const
+{
+    cout << "Total number of tasks: " << getTaskCount() << endl;
+}
+
+void SharedTaskReader::displayTaskDetails(int task_id) const
+{
+    Task task;
+    if (!findTask(task_id, task))
+    {
+        cout << "Error: Task not found." << endl;
+        return;
+    }
+
+    cout << "Task ID: " << task.task_id << endl;
+    cout << "Title: " << task.title << endl;
+    cout << "Description: " << task.description << endl;
+    cout << "Priority: " << formatPriorityName(task.priority) << endl;
+    cout << "Status: " << (task.is_completed ? "Completed" : "Incomplete") << endl;
+    if (task.due_date != NO_DUE_DATE)
+    {
+        cout << "Due date: " << task.due_date << endl;
+    }
+}
+
+// Matches in place against the shared bytes; only hits are copied out
+void SharedTaskReader::searchText(const string &text, bool in_title) const
+{
+    vector<pair<int, string>> matches;
+    if (base != nullptr)
+    {
+        readConsistent([&](const SharedHeader *header) {
+            matches.clear();
+            const SharedRecord *records = at<SharedRecord>(base, header->records_offset);
+            const char *arena = base + header->arena_offset;
+            uint32_t count = liveCount(header);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const SharedRecord &record = records[i];
+                string_view field = in_title
+                    ? arenaText(arena, header->arena_size, record.title_offset, record.title_length)
+                    : arenaText(arena, header->arena_size, record.description_offset, record.description_length);
+                if (field.find(text) != string_view::npos)
+                {
+                    string_view title = arenaText(arena, header->arena_size, record.title_offset, record.title_length);
+                    matches.emplace_back(record.task_id, string(title));
+                }
+            }
+        });
+    }
+
+    cout << "Searching tasks with " << (in_title ? "title" : "description") << " containing '" << text << "':" << endl;
+    for (const auto &match : matches)
+    {
+        cout << "Task ID: " << match.first << ", Title: " << match.second << endl;
+    }
+}
+
+void SharedTaskReader::searchTaskByTitle(const string &title) const
+{
+    searchText(title, true);
+}
+
+void SharedTaskReader::searchTaskByDescription(const string &description) const
+{
+    searchText(description, false);
+}
+
+void SharedTaskReader::countTasksByStatus() const
+{
+    int completed = 0, incomplete = 0;
+    if (base != nullptr)
+    {
+        readConsistent([&](const SharedHeader *header) {
+            const SharedRecord *records = at<SharedRecord>(base, header->records_offset);
+            uint32_t count = liveCount(header);
+            completed = 0;
+            for (uint32_t i = 0; i < count; ++i)
+                completed += records[i].completed != 0 ? 1 : 0;
+            incomplete = static_cast<int>(count) - completed;
+        });
+    }
+    cout << "Completed tasks: " << completed << endl;
+    cout << "Incomplete tasks: " << incomplete << endl;
+}
+
+void SharedTaskReader::countTasksByPriority() const
+{
+    int counts[3] = {0, 0, 0};
+    if (base != nullptr)
+    {
+        readConsistent([&](const SharedHeader *header) {
+            const SharedRecord *records = at<SharedRecord>(base, header->records_offset);
+            uint32_t count = liveCount(header);
+            counts[0] = counts[1] = counts[2] = 0;
+            for (uint32_t i = 0; i < count; ++i)
+                ++counts[min<uint8_t>(records[i].priority, 2)];
+        });
+    }
+    cout << "Low priority tasks: " << counts[0] << endl;
+    cout << "Medium priority tasks: " << counts[1] << endl;
+    cout << "High priority tasks: " << counts[2] << endl;
+}
@@ -0,0 +1,86 @@
+#ifndef SHARED_TASK_STORE_H
+#define SHARED_TASK_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "task.h"
+
+// Task store in a POSIX shared-memory segment, written by one process and
+// read by any number of others.
+//
+// The segment holds a header, a dense array of fixed-size records, an
+// open-addressing id -> record table and a string arena. Everything refers
+// to everything else by offset from the segment start, so each process can
+// map it at a different address. The writer brackets every change with a
+// sequence counter (seqlock). Readers never block it: they copy what they
+// need, then retry if the counter moved or was odd while they read.
+class SharedTaskStore
+{
+public:
+    SharedTaskStore();
+    ~SharedTaskStore();
+    SharedTaskStore(const SharedTaskStore &) = delete;
+    SharedTaskStore& operator=(const SharedTaskStore &) = delete;
+
+    // Creates the named segment, replacing any existing one; name must start
+    // with '/'. Readers that mapped the old segment keep a frozen copy of it
+    // and must reopen to see further changes.
+    bool create(const std::string &name, uint32_t capacity, size_t arena_bytes);
+
+    // Inserts the task or overwrites the record with the same id. Returns
+    // false if the store is full or the strings do not fit in the arena; in
+    // that case any existing record for the id is erased, so readers see the
+    // task as missing rather than out of date.
+    bool put(const Task &task);
+    bool erase(int task_id);
+    void clear();
+
+    uint32_t size() const;
+
+private:
+    void storeString(const std::string &text, uint64_t &offset, uint32_t &length);
+    void compactArena();
+    void beginWrite();
+    void endWrite();
+
+    std::string name;
+    char *base;
+    size_t mapped_size;
+};
+
+// Read-only view of a SharedTaskStore from any process. Lookups and scans
+// run without locks and are validated against the writer's sequence counter.
+class SharedTaskReader
+{
+public:
+    SharedTaskReader();
+    ~SharedTaskReader();
+    SharedTaskReader(const SharedTaskReader &) = delete;
+    SharedTaskReader& operator=(const SharedTaskReader &) = delete;
+
+    bool open(const std::string &name);
+
+    int getTaskCount() const;
+    bool findTask(int task_id, Task &task) const;
+    std::vector<Task> getAllTasks() const;
+
+    // Same output as the TaskManager functions of the same name
+    void displayTaskCount() const;
+    void displayTaskDetails(int task_id) const;
+    void searchTaskByTitle(const std::string &title) const;
+    void searchTaskByDescription(const std::string &description) const;
+    void countTasksByStatus() const;
+    void countTasksByPriority() const;
+
+private:
+    template <typename Function>
+    void readConsistent(Function fn) const;
+    void searchText(const std::string &text, bool in_title) const;
+
+    const char *base;
+    size_t mapped_size;
+};
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef TASK_H
+#define TASK_H
+
+#include <string>
+
+constexpr long long NO_DUE_DATE = -1;
+
+// Enum for task priority
+enum class Priority {
+    LOW,
+    MEDIUM,
+    HIGH
+};
+
+// Structure to represent a task
+struct Task
+{
+    int task_id;
+    std::string title;
+    std::string description;
+    Priority priority;
+    bool is_completed;
+    long long due_date;  // seconds on the manager's clock, or NO_DUE_DATE
+};
+
+#endif
@@ -0,0 +1,371 @@
+#include "task_graph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+namespace
+{
+const vector<int> empty_ids;
+
+void eraseValue(vector<int> &values, int value)
+{
+    auto it = find(values.begin(), values.end(), value);
+    if (it != values.end())
+    {
+        *it = values.back();
+        values.pop_back();
+    }
+}
+}
+
+bool TaskGraph::addNode(int id)
+{
+    if (!nodes.emplace(id, Node()).second)
+    {
+        return false;
+    }
+    ready.insert(id);
+    return true;
+}
+
+void TaskGraph::removeNode(int id)
+{
+    auto it = nodes.find(id);
+    if (it == nodes.end())
+    {
+        return;
+    }
+
+    Node &node = it->second;
+    for (int prereq : node.prerequisites)
+    {
+        eraseValue(nodes[prereq].dependents, id);
+    }
+    for (int dependent_id : node.dependents)
+    {
+        Node &dependent = nodes[dependent_id];
+        eraseValue(dependent.prerequisites, id);
+        if (!node.completed && --dependent.pending == 0 && !dependent.completed)
+        {
+            ready.insert(dependent_id);
+        }
+    }
+
+    edge_count -= node.prerequisites.size() + node.dependents.size();
+    ready.erase(id);
+    nodes.erase(it);
+}
+
+bool TaskGraph::hasNode(int id) const
+{
+    return nodes.count(id) != 0;
+}
+
+void TaskGraph::clear()
+{
+    nodes.clear();
+    ready.clear();
+    edge_count = 0;
+}
+
+bool TaskGraph::wouldCreateCycle(int dependent, int prerequisite) const
+{
+    if (nodes.find(dependent) == nodes.end() || nodes.find(prerequisite) == nodes.end())
+    {
+        return false;
+    }
+    if (dependent == prerequisite)
+    {
+        return true;
+    }
+
+    // A cycle appears iff the prerequisite is already reachable from the dependent
+    unordered_set<int> visited;
+    vector<int> stack{dependent};
+    visited.insert(dependent);
+    while (!stack.empty())
+    {
+        int current = stack.back();
+        stack.pop_back();
+        auto it = nodes.find(current);
+        if (it == nodes.end())
+        {
+            continue;
+        }
+        for (int next : it->second.dependents)
+        {
+            if (next == prerequisite)
+            {
+                return true;
+            }
+            if (visited.insert(next).second)
+            {
+                stack.push_back(next);
+            }
+        }
+    }
+    return false;
+}
+
+DependencyResult TaskGraph::addDependency(int dependent, int prerequisite)
+{
+    auto dep_it = nodes.find(dependent);
+    auto pre_it = nodes.find(prerequisite);
+    if (dep_it == nodes.end() || pre_it == nodes.end())
+    {
+        return DependencyResult::UNKNOWN_TASK;
+    }
+
+    const vector<int> &existing = dep_it->second.prerequisites;
+    if (find(existing.begin(), existing.end(), prerequisite) != existing.end())
+    {
+        return DependencyResult::ALREADY_EXISTS;
+    }
+    if (wouldCreateCycle(dependent, prerequisite))
+    {
+        return DependencyResult::CYCLE;
+    }
+
+    dep_it->second.prerequisites.push_back(prerequisite);
+    pre_it->second.dependents.push_back(dependent);
+    ++edge_count;
+
+    if (!pre_it->second.completed && dep_it->second.pending++ == 0)
+    {
+        ready.erase(dependent);
+    }
+    return DependencyResult::ADDED;
+}
+
+bool TaskGraph::removeDependency(int dependent, int prerequisite)
+{
+    auto dep_it = nodes.find(dependent);
+    auto pre_it = nodes.find(prerequisite);
+    if (dep_it == nodes.end() || pre_it == nodes.end())
+    {
+        return false;
+    }
+
+    vector<int> &prereqs = dep_it->second.prerequisites;
+    if (find(prereqs.begin(), prereqs.end(), prerequisite) == prereqs.end())
+    {
+        return false;
+    }
+
+    eraseValue(prereqs, prerequisite);
+    eraseValue(pre_it->second.dependents, dependent);
+    --edge_count;
+
+    Node &node = dep_it->second;
+    if (!pre_it->second.completed && --node.pending == 0 && !node.completed)
+    {
+        ready.insert(dependent);
+    }
+    return true;
+}
+
+void TaskGraph::markCompleted(int id)
+{
+    auto it = nodes.find(id);
+    if (it == nodes.end() || it->second.completed)
+    {
+        return;
+    }
+
+    it->second.completed = true;
+    ready.erase(id);
+    for (int dependent_id : it->second.dependents)
+    {
+        Node &dependent = nodes[dependent_id];
+        if (--dependent.pending == 0 && !dependent.completed)
+        {
+            ready.insert(dependent_id);
+        }
+    }
+}
+
+void TaskGraph::markIncomplete(int id)
+{
+    auto it = nodes.find(id);
+    if (it == nodes.end() || !it->second.completed)
+    {
+        return;
+    }
+
+    it->second.completed = false;
+    if (it->second.pending == 0)
+    {
+        ready.insert(id);
+    }
+    for (int dependent_id : it->second.dependents)
+    {
+        if (nodes[dependent_id].pending++ == 0)
+        {
+            ready.erase(dependent_id);
+        }
+    }
+}
+
+bool TaskGraph::isReady(int id) const
+{
+    return ready.count(id) != 0;
+}
+
+vector<int> TaskGraph::getReadyNodes() const
+{
+    vector<int> ids(ready.begin(), ready.end());
+    sort(ids.begin(), ids.end());
+    return ids;
+}
+
+size_t TaskGraph::readyCount() const
+{
+    return ready.size();
+}
+
+const vector<int>& TaskGraph::getPrerequisites(int id) const
+{
+    auto it = nodes.find(id);
+    return it == nodes.end() ? empty_ids : it->second.prerequisites;
+}
+
+const vector<int>& TaskGraph::getDependents(int id) const
+{
+    auto it = nodes.find(id);
+    return it == nodes.end() ? empty_ids : it->second.dependents;
+}
+
+size_t TaskGraph::nodeCount() const
+{
+    return nodes.size();
+}
+
+size_t TaskGraph::edgeCount() const
+{
+    return edge_count;
+}
+
+void TaskGraph::parallelWalk(const function<void(int)> &visit, unsigned num_threads) const
+{
+    // Flatten the incomplete subgraph into dense indices and a CSR adjacency
+    // list so workers never touch the hash maps.
+    vector<int> ids;
+    unordered_map<int, size_t> index;
+    ids.reserve(nodes.size());
+    index.reserve(nodes.size());
+    for (const auto &entry : nodes)
+    {
+        if (!entry.second.completed)
+        {
+            index.emplace(entry.first, ids.size());
+            ids.push_back(entry.first);
+        }
+    }
+    if (ids.empty())
+    {
+        return;
+    }
+
+    vector<size_t> offsets(ids.size() + 1, 0);
+    vector<size_t> targets;
+    unique_ptr<atomic<int>[]> pending(new atomic<int>[ids.size()]);
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        const Node &node = nodes.at(ids[i]);
+        pending[i].store(node.pending, memory_order_relaxed);
+        for (int dependent_id : node.dependents)
+        {
+            auto target = index.find(dependent_id);
+            if (target != index.end())
+            {
+                targets.push_back(target->second);
+            }
+        }
+        offsets[i + 1] = targets.size();
+    }
+
+    mutex queue_mutex;
+    condition_variable queue_cv;
+    vector<size_t> queue;
+    atomic<size_t> remaining(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        if (pending[i].load(memory_order_relaxed) == 0)
+        {
+            queue.push_back(i);
+        }
+    }
+
+    auto worker = [&]() {
+        vector<size_t> released;
+        for (;;)
+        {
+            size_t current;
+            {
+                unique_lock<mutex> lock(queue_mutex);
+                queue_cv.wait(lock, [&]() { return !queue.empty() || remaining == 0; });
+                if (queue.empty())
+                {
+                    return;
+                }
+                current = queue.back();
+                queue.pop_back();
+            }
+
+            // Keep running down a chain locally; only share surplus work
+            for (;;)
+            {
+                visit(ids[current]);
+                released.clear();
+                for (size_t e = offsets[current]; e < offsets[current + 1]; ++e)
+                {
+                    if (pending[targets[e]].fetch_sub(1, memory_order_acq_rel) == 1)
+                    {
+                        released.push_back(targets[e]);
+                    }
+                }
+
+                bool done = remaining.fetch_sub(1, memory_order_acq_rel) == 1;
+                if (released.size() > 1)
+                {
+                    {
+                        lock_guard<mutex> lock(queue_mutex);
+                        queue.insert(queue.end(), released.begin() + 1, released.end());
+                    }
+                    queue_cv.notify_all();
+                }
+                if (done)
+                {
+                    {
+                        lock_guard<mutex> lock(queue_mutex);
+                    }
+                    queue_cv.notify_all();
+                    return;
+                }
+                if (released.empty())
+                {
+                    break;
+                }
+                current = released.front();
+            }
+        }
+    };
+
+    num_threads = max(1u, num_threads);
+    vector<thread> workers;
+    for (unsigned t = 1; t < num_threads; ++t)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto &w : workers)
+    {
+        w.join();
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+enum class DependencyResult {
+    ADDED,
+    UNKNOWN_TASK,
+    ALREADY_EXISTS,
+    CYCLE  // includes self-loops
+};
+
+// Dependency graph between task ids.
+// An edge prerequisite -> dependent means the dependent cannot start until the
+// prerequisite is completed. Each node keeps a count of its incomplete
+// prerequisites, so completing a task only touches its direct dependents.
+class TaskGraph
+{
+public:
+    // Node management
+    bool addNode(int id);
+    void removeNode(int id);
+    bool hasNode(int id) const;
+    void clear();
+
+    // Edge management. addDependency runs the cycle check itself, so callers
+    // need not call wouldCreateCycle first. wouldCreateCycle is false for
+    // unknown ids.
+    DependencyResult addDependency(int dependent, int prerequisite);
+    bool removeDependency(int dependent, int prerequisite);
+    bool wouldCreateCycle(int dependent, int prerequisite) const;
+
+    // Completion state, O(out-degree)
+    void markCompleted(int id);
+    void markIncomplete(int id);
+
+    // Ready set: incomplete nodes whose prerequisites are all completed
+    bool isReady(int id) const;
+    std::vector<int> getReadyNodes() const;
+    size_t readyCount() const;
+
+    const std::vector<int>& getPrerequisites(int id) const;
+    const std::vector<int>& getDependents(int id) const;
+    size_t nodeCount() const;
+    size_t edgeCount() const;
+
+    // Visits every incomplete node after all of its incomplete prerequisites
+    // have been visited, using up to num_threads workers. The graph itself is
+    // not modified; visit must be safe to call concurrently.
+    void parallelWalk(const std::function<void(int)> &visit, unsigned num_threads) const;
+
+private:
+    struct Node
+    {
+        std::vector<int> prerequisites;
+        std::vector<int> dependents;
+        int pending = 0;  // number of incomplete prerequisites
+        bool completed = false;
+    };
+
+    std::unordered_map<int, Node> nodes;
+    std::unordered_set<int> ready;
+    size_t edge_count = 0;
+};
+
+#endif
@@ -0,0 +1,721 @@
+#include "task_io.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace task_io
+{
+namespace
+{
+constexpr size_t MIN_PIECE_SIZE = 1 << 20;
+constexpr size_t EXPORT_FLUSH_SIZE = 1 << 20;
+constexpr int CSV_COLUMNS = 6;
+
+// A slice of the input parsed by one thread
+struct Piece
+{
+    const char *begin = nullptr;
+    const char *end = nullptr;
+    bool may_have_header = false;
+    vector<Task> tasks;
+    size_t malformed = 0;
+};
+
+const char* priorityName(Priority priority)
+{
+    switch (priority)
+    {
+    case Priority::LOW:
+        return "Low";
+    case Priority::MEDIUM:
+        return "Medium";
+    case Priority::HIGH:
+        return "High";
+    default:
+        return "Unknown";
+    }
+}
+
+bool equalsIgnoreCase(string_view a, string_view b)
+{
+    return a.size() == b.size() &&
+           equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return tolower(static_cast<unsigned char>(x)) == tolower(static_cast<unsigned char>(y));
+           });
+}
+
+bool parsePriority(string_view text, Priority &priority)
+{
+    if (text == "0" || equalsIgnoreCase(text, "low"))
+        priority = Priority::LOW;
+    else if (text == "1" || equalsIgnoreCase(text, "medium"))
+        priority = Priority::MEDIUM;
+    else if (text == "2" || equalsIgnoreCase(text, "high"))
+        priority = Priority::HIGH;
+    else
+        return false;
+    return true;
+}
+
+bool parseCompleted(string_view text, bool &completed)
+{
+    if (text == "1" || text == "true")
+        completed = true;
+    else if (text == "0" || text == "false")
+        completed = false;
+    else
+        return false;
+    return true;
+}
+
+bool parseDueDate(string_view text, long long &due_date)
+{
+    if (text.empty() || text == "null")
+    {
+        due_date = NO_DUE_DATE;
+        return true;
+    }
+    auto parsed = from_chars(text.data(), text.data() + text.size(), due_date);
+    return parsed.ec == errc() && parsed.ptr == text.data() + text.size();
+}
+
+const char* skipLine(const char *p, const char *end)
+{
+    const char *newline = static_cast<const char *>(memchr(p, '\n', static_cast<size_t>(end - p)));
+    return newline == nullptr ? end : newline + 1;
+}
+
+// ---- CSV ----
+
+// Reads one field into out and consumes its delimiter. Unquoted fields are
+// copied straight from the buffer; quoted ones only pay for unescaping "".
+bool parseCsvField(const char *&p, const char *end, string &out, bool &record_end)
+{
+    out.clear();
+    record_end = false;
+    if (p < end && *p == '"')
+    {
+        ++p;
+        for (;;)
+        {
+            const char *quote = static_cast<const char *>(memchr(p, '"', static_cast<size_t>(end - p)));
+            if (quote == nullptr)
+                return false;
+            out.append(p, quote);
+            p = quote + 1;
+            if (p < end && *p == '"')
+            {
+                out.push_back('"');
+                ++p;
+                continue;
+            }
+            break;
+        }
+    }
+    else
+    {
+        const char *start = p;
+        while (p < end && *p != ',' && *p != '\n' && *p != '\r')
+            ++p;
+        out.assign(start, p);
+    }
+
+    if (p < end && *p == ',')
+    {
+        ++p;
+        return true;
+    }
+    if (p < end && *p == '\r')
+        ++p;
+    if (p < end && *p == '\n')
+        ++p;
+    else if (p != end)
+        return false;
+    record_end = true;
+    return true;
+}
+
+void parseCsvPiece(Piece &piece)
+{
+    const char *p = piece.begin;
+    string scratch[CSV_COLUMNS];
+    bool first = true;
+
+    while (p < piece.end)
+    {
+        if (*p == '\n' || (*p == '\r' && p + 1 < piece.end && p[1] == '\n'))
+        {
+            p = skipLine(p, piece.end);
+            continue;
+        }
+
+        Task task;
+        string *targets[CSV_COLUMNS] = {&scratch[0], &task.title, &task.description,
+                                        &scratch[3], &scratch[4], &scratch[5]};
+        int column = 0;
+        bool record_end = false;
+        bool ok = true;
+        while (ok && !record_end)
+        {
+            string &out = column < CSV_COLUMNS ? *targets[column] : scratch[0];
+            ok = parseCsvField(p, piece.end, out, record_end);
+            ++column;
+        }
+
+        bool header = first && piece.may_have_header && ok && column == CSV_COLUMNS && scratch[0] == "id";
+        first = false;
+        if (header)
+            continue;
+
+        task.task_id = 0;
+        ok = ok && column == CSV_COLUMNS && parsePriority(scratch[3], task.priority) &&
+             parseCompleted(scratch[4], task.is_completed) && parseDueDate(scratch[5], task.due_date);
+        if (ok)
+        {
+            piece.tasks.push_back(move(task));
+        }
+        else
+        {
+            ++piece.malformed;
+            if (!record_end)
+                p = skipLine(p, piece.end);
+        }
+    }
+}
+
+// ---- JSON Lines ----
+
+enum class JsonKind {
+    STRING,
+    NUMBER,
+    TRUE,
+    FALSE,
+    NUL
+};
+
+void skipSpace(const char *&p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+        ++p;
+}
+
+void appendUtf8(string &out, uint32_t code)
+{
+    if (code < 0x80)
+    {
+        out.push_back(static_cast<char>(code));
+    }
+    else if (code < 0x800)
+    {
+        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+    else if (code < 0x10000)
+    {
+        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+    else
+    {
+        out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+bool parseHex4(const char *&p, const char *end, uint32_t &value)
+{
+    if (end - p < 4)
+        return false;
+    auto parsed = from_chars(p, p + 4, value, 16);
+    if (parsed.ptr != p + 4)
+        return false;
+    p += 4;
+    return true;
+}
+
+// Expects p at the opening quote
+bool parseJsonString(const char *&p, const char *end, string &out)
+{
+    out.clear();
+    ++p;
+    for (;;)
+    {
+        const char *start = p;
+        while (p < end && *p != '"' && *p != '\\')
+            ++p;
+        out.append(start, p);
+        if (p == end)
+            return false;
+        if (*p++ == '"')
+            return true;
+        if (p == end)
+            return false;
+
+        char escape = *p++;
+        switch (escape)
+        {
+        case '"': out.push_back('"'); break;
+        case '\\': out.push_back('\\'); break;
+        case '/': out.push_back('/'); break;
+        case 'b': out.push_back('\b'); break;
+        case 'f': out.push_back('\f'); break;
+        case 'n': out.push_back('\n'); break;
+        case 'r': out.push_back('\r'); break;
+        case 't': out.push_back('\t'); break;
+        case 'u':
+        {
+            uint32_t code;
+            if (!parseHex4(p, end, code))
+                return false;
+            uint32_t low;
+            if (code >= 0xD800 && code < 0xDC00 && end - p >= 2 && p[0] == '\\' && p[1] == 'u')
+            {
+                const char *save = p;
+                p += 2;
+                if (parseHex4(p, end, low) && low >= 0xDC00 && low < 0xE000)
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                else
+                    p = save;
+            }
+            appendUtf8(out, code);
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+}
+
+bool parseJsonValue(const char *&p, const char *end, string &out, JsonKind &kind)
+{
+    if (p == end)
+        return false;
+    if (*p == '"')
+    {
+        kind = JsonKind::STRING;
+        return parseJsonString(p, end, out);
+    }
+
+    const char *start = p;
+    while (p < end && *p != ',' && *p != '}' && *p != ' ' && *p != '\t' && *p != '\r')
+        ++p;
+    string_view token(start, static_cast<size_t>(p - start));
+    if (token == "true")
+        kind = JsonKind::TRUE;
+    else if (token == "false")
+        kind = JsonKind::FALSE;
+    else if (token == "null")
+        kind = JsonKind::NUL;
+    else if (!token.empty() && (token[0] == '-' || isdigit(static_cast<unsigned char>(token[0]))))
+        kind = JsonKind::NUMBER;
+    else
+        return false;
+    out.assign(token);
+    return true;
+}
+
+bool parseJsonRecord(const char *p, const char *end, Task &task, string &key, string &value)
+{
+    task.task_id = 0;
+    task.priority = Priority::LOW;
+    task.is_completed = false;
+    task.due_date = NO_DUE_DATE;
+    bool has_title = false;
+
+    skipSpace(p, end);
+    if (p == end || *p++ != '{')
+        return false;
+
+    for (;;)
+    {
+        skipSpace(p, end);
+        if (p == end || *p != '"' || !parseJsonString(p, end, key))
+            return false;
+        skipSpace(p, end);
+        if (p == end || *p++ != ':')
+            return false;
+        skipSpace(p, end);
+
+        // Titles and descriptions decode straight into the task
+        string &target = key == "title" ? task.title : key == "description" ? task.description : value;
+        JsonKind kind;
+        if (!parseJsonValue(p, end, target, kind))
+            return false;
+
+        bool ok = true;
+        if (key == "title")
+            ok = has_title = kind == JsonKind::STRING;
+        else if (key == "description")
+            ok = kind == JsonKind::STRING;
+        else if (key == "priority")
+            ok = (kind == JsonKind::STRING || kind == JsonKind::NUMBER) && parsePriority(value, task.priority);
+        else if (key == "completed")
+            ok = kind != JsonKind::STRING && kind != JsonKind::NUL && parseCompleted(value, task.is_completed);
+        else if (key == "due_date")
+            ok = (kind == JsonKind::NUL || kind == JsonKind::NUMBER) && parseDueDate(value, task.due_date);
+        if (!ok)
+            return false;
+
+        skipSpace(p, end);
+        if (p == end)
+            return false;
+        if (*p == ',')
+        {
+            ++p;
+            continue;
+        }
+        if (*p++ != '}')
+            return false;
+        break;
+    }
+
+    skipSpace(p, end);
+    return p == end && has_title;
+}
+
+void parseJsonlPiece(Piece &piece)
+{
+    const char *p = piece.begin;
+    string key, value;
+    while (p < piece.end)
+    {
+        const char *line_end = static_cast<const char *>(memchr(p, '\n', static_cast<size_t>(piece.end - p)));
+        if (line_end == nullptr)
+            line_end = piece.end;
+
+        const char *first = p;
+        skipSpace(first, line_end);
+        if (first != line_end)
+        {
+            Task task;
+            if (parseJsonRecord(p, line_end, task, key, value))
+                piece.tasks.push_back(move(task));
+            else
+                ++piece.malformed;
+        }
+        p = line_end == piece.end ? line_end : line_end + 1;
+    }
+}
+
+// ---- Splitting ----
+
+size_t countQuotes(const char *begin, const char *end)
+{
+    size_t count = 0;
+    for (const char *p = begin; (p = static_cast<const char *>(memchr(p, '"', static_cast<size_t>(end - p)))) != nullptr; ++p)
+        ++count;
+    return count;
+}
+
+template <typename Function>
+void runParallel(size_t count, Function fn)
+{
+    vector<thread> workers;
+    for (size_t i = 1; i < count; ++i)
+        workers.emplace_back(fn, i);
+    fn(0);
+    for (auto &worker : workers)
+        worker.join();
+}
+
+// Parses the complete records at the start of [data, data + size) and
+// returns how many bytes they covered. With final set, everything is parsed.
+size_t processWindow(const char *data, size_t size, bool final, bool first_window, Format format,
+                     unsigned threads, const BatchSink &sink, ImportResult &result)
+{
+    size_t pieces = max<size_t>(1, min<size_t>(threads, size / MIN_PIECE_SIZE));
+    vector<size_t> bounds(pieces + 1);
+    for (size_t i = 0; i <= pieces; ++i)
+        bounds[i] = size * i / pieces;
+
+    // CSV quoted fields may span lines, so split points depend on the quote
+    // parity before them. Count quotes per piece in parallel, then prefix-sum.
+    vector<size_t> quotes(pieces, 0);
+    if (format == Format::CSV)
+        runParallel(pieces, [&](size_t i) { quotes[i] = countQuotes(data + bounds[i], data + bounds[i + 1]); });
+    vector<bool> in_quotes(pieces + 1, false);
+    for (size_t i = 0; i < pieces; ++i)
+        in_quotes[i + 1] = in_quotes[i] != (quotes[i] % 2 == 1);
+
+    size_t limit = size;
+    if (!final)
+    {
+        // Stop after the last record terminator in the window
+        limit = 0;
+        bool quoted = in_quotes[pieces];
+        for (size_t k = size; k-- > 0;)
+        {
+            if (format == Format::CSV && data[k] == '"')
+                quoted = !quoted;
+            if (data[k] == '\n' && !quoted)
+            {
+                limit = k + 1;
+                break;
+            }
+        }
+        if (limit == 0)
+            return 0;
+    }
+
+    // Move each interior split forward to just past a record terminator
+    for (size_t i = 1; i < pieces; ++i)
+    {
+        if (bounds[i - 1] >= bounds[i] || bounds[i] >= limit)
+        {
+            bounds[i] = min(max(bounds[i - 1], bounds[i]), limit);
+            continue;
+        }
+        size_t k = bounds[i];
+        bool quoted = format == Format::CSV && in_quotes[i];
+        while (k < limit && (data[k] != '\n' || quoted))
+        {
+            if (format == Format::CSV && data[k] == '"')
+                quoted = !quoted;
+            ++k;
+        }
+        bounds[i] = min(limit, k + 1);
+    }
+    bounds[pieces] = limit;
+
+    vector<Piece> parsed(pieces);
+    for (size_t i = 0; i < pieces; ++i)
+    {
+        parsed[i].begin = data + bounds[i];
+        parsed[i].end = data + bounds[i + 1];
+        parsed[i].may_have_header = first_window && i == 0;
+    }
+    runParallel(pieces, [&](size_t i) {
+        if (format == Format::CSV)
+            parseCsvPiece(parsed[i]);
+        else
+            parseJsonlPiece(parsed[i]);
+    });
+
+    for (auto &piece : parsed)
+    {
+        result.records += piece.tasks.size();
+        result.malformed += piece.malformed;
+        if (!piece.tasks.empty())
+            sink(piece.tasks);
+    }
+    return limit;
+}
+
+unsigned threadCount(const ImportOptions &options)
+{
+    unsigned threads = options.threads != 0 ? options.threads : thread::hardware_concurrency();
+    return max(1u, threads);
+}
+
+// ---- Export ----
+
+void appendCsvField(string &out, const string &field)
+{
+    if (field.find_first_of(",\"\r\n") == string::npos)
+    {
+        out += field;
+        return;
+    }
+    out.push_back('"');
+    for (char c : field)
+    {
+        if (c == '"')
+            out.push_back('"');
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+void appendJsonString(string &out, const string &text)
+{
+    static const char hex[] = "0123456789abcdef";
+    out.push_back('"');
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out += "\\u00";
+                out.push_back(hex[(c >> 4) & 0xF]);
+                out.push_back(hex[c & 0xF]);
+            }
+            else
+            {
+                out.push_back(c);
+            }
+        }
+    }
+    out.push_back('"');
+}
+}
+
+ImportResult importBuffer(const char *data, size_t size, Format format, const BatchSink &sink,
+                          const ImportOptions &options)
+{
+    ImportResult result;
+    result.opened = true;
+    unsigned threads = threadCount(options);
+    size_t block = max<size_t>(options.block_size, 1);
+    size_t offset = 0;
+    while (offset < size)
+    {
+        size_t window = min(block, size - offset);
+        bool final = offset + window == size;
+        size_t consumed = processWindow(data + offset, window, final, offset == 0, format, threads, sink, result);
+        if (consumed == 0)
+        {
+            block *= 2;  // a single record is larger than the window
+            continue;
+        }
+        offset += consumed;
+    }
+    return result;
+}
+
+ImportResult importFile(const string &path, Format format, const BatchSink &sink, const ImportOptions &options)
+{
+    ImportResult result;
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return result;
+
+    struct stat info;
+    if (options.use_mmap && fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+    {
+        size_t size = static_cast<size_t>(info.st_size);
+        if (size == 0)
+        {
+            close(fd);
+            result.opened = true;
+            return result;
+        }
+        void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED)
+        {
+            madvise(mapped, size, MADV_SEQUENTIAL);
+            result = importBuffer(static_cast<const char *>(mapped), size, format, sink, options);
+            munmap(mapped, size);
+            close(fd);
+            return result;
+        }
+    }
+
+    // Streaming read: keep the unparsed tail of each block for the next one
+    result.opened = true;
+    unsigned threads = threadCount(options);
+    size_t block = max<size_t>(options.block_size, 1);
+    string buffer;
+    bool eof = false;
+    bool first_window = true;
+    while (!eof || !buffer.empty())
+    {
+        size_t old_size = buffer.size();
+        if (!eof)
+        {
+            buffer.resize(old_size + block);
+            size_t filled = 0;
+            while (filled < block)
+            {
+                ssize_t n = read(fd, &buffer[old_size + filled], block - filled);
+                if (n <= 0)
+                {
+                    eof = true;
+                    break;
+                }
+                filled += static_cast<size_t>(n);
+            }
+            buffer.resize(old_size + filled);
+        }
+
+        size_t consumed = processWindow(buffer.data(), buffer.size(), eof, first_window, format, threads, sink, result);
+        if (consumed > 0)
+            first_window = false;
+        buffer.erase(0, consumed);
+    }
+    close(fd);
+    return result;
+}
+
+void formatHeader(Format format, string &out)
+{
+    if (format == Format::CSV)
+        out += "id,title,description,priority,completed,due_date\n";
+}
+
+void formatTask(const Task &task, Format format, string &out)
+{
+    if (format == Format::CSV)
+    {
+        out += to_string(task.task_id);
+        out.push_back(',');
+        appendCsvField(out, task.title);
+        out.push_back(',');
+        appendCsvField(out, task.description);
+        out.push_back(',');
+        out += priorityName(task.priority);
+        out += task.is_completed ? ",1," : ",0,";
+        if (task.due_date != NO_DUE_DATE)
+            out += to_string(task.due_date);
+        out.push_back('\n');
+        return;
+    }
+
+    out += "{\"id\":";
+    out += to_string(task.task_id);
+    out += ",\"title\":";
+    appendJsonString(out, task.title);
+    out += ",\"description\":";
+    appendJsonString(out, task.description);
+    out += ",\"priority\":\"";
+    out += priorityName(task.priority);
+    out += task.is_completed ? "\",\"completed\":true,\"due_date\":" : "\",\"completed\":false,\"due_date\":";
+    out += task.due_date == NO_DUE_DATE ? "null" : to_string(task.due_date);
+    out += "}\n";
+}
+
+long long exportFile(const TaskSnapshot &tasks, const string &path, Format format)
+{
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return -1;
+
+    string buffer;
+    buffer.reserve(EXPORT_FLUSH_SIZE + 4096);
+    formatHeader(format, buffer);
+    long long written = 0;
+    bool ok = true;
+    for (const auto &task : tasks)
+    {
+        formatTask(task, format, buffer);
+        ++written;
+        if (buffer.size() >= EXPORT_FLUSH_SIZE)
+        {
+            ok = ok && fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+            buffer.clear();
+        }
+    }
+    ok = ok && fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    ok = fclose(file) == 0 && ok;
+    return ok ? written : -1;
+}
+}
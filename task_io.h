@@ -0,0 +1,61 @@
+#ifndef TASK_IO_H
+#define TASK_IO_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "task.h"
+#include "task_store.h"
+
+// Streaming bulk import and export of tasks as CSV or JSON Lines.
+//
+// CSV columns: id,title,description,priority,completed,due_date with an
+// optional header row and RFC 4180 quoting. JSON Lines: one flat object per
+// line with the same keys. Priority is written as "Low"/"Medium"/"High"
+// (digits 0-2 are accepted on import), completed as 0/1 or false/true, and a
+// missing due date as an empty field or null. Imported ids are ignored; the
+// store assigns new ones.
+//
+// Input is processed in large blocks. Each block is split at record
+// boundaries and the pieces are parsed in parallel straight out of the
+// (optionally memory-mapped) buffer. Parsed records reach the sink in file
+// order, one batch per piece.
+namespace task_io
+{
+enum class Format {
+    CSV,
+    JSONL
+};
+
+struct ImportOptions
+{
+    unsigned threads = 0;               // 0 means one per hardware thread
+    bool use_mmap = true;               // map the file instead of reading it
+    size_t block_size = 64 << 20;       // bytes parsed per round
+};
+
+struct ImportResult
+{
+    bool opened = false;
+    size_t records = 0;    // well-formed records delivered to the sink
+    size_t malformed = 0;  // records skipped because they did not parse
+};
+
+// Receives consecutive batches; it may move the tasks out
+using BatchSink = std::function<void(std::vector<Task> &batch)>;
+
+ImportResult importFile(const std::string &path, Format format, const BatchSink &sink,
+                        const ImportOptions &options = ImportOptions());
+ImportResult importBuffer(const char *data, size_t size, Format format, const BatchSink &sink,
+                          const ImportOptions &options = ImportOptions());
+
+// Appends one encoded record, including the trailing newline
+void formatTask(const Task &task, Format format, std::string &out);
+void formatHeader(Format format, std::string &out);
+
+// Returns the number of records written, or -1 if the file cannot be written
+long long exportFile(const TaskSnapshot &tasks, const std::string &path, Format format);
+}
+
+#endif
@@ -0,0 +1,238 @@
+// Load generator for task_server: measures throughput and tail latency.
+// Build: g++ -O2 -std=c++17 task_load_client.cpp task_protocol.cpp -pthread -o task_load_client
+// Usage: ./task_load_client [socket_path] [connections] [requests_per_connection] [pipeline_depth]
+#include "task_protocol.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace task_protocol;
+using Clock = chrono::steady_clock;
+
+namespace
+{
+constexpr int PRELOADED_TASKS = 64;
+
+int connectTo(const string &socket_path)
+{
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+bool sendAll(int fd, const string &data)
+{
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+            return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Reads until at least one complete frame is buffered; returns false on EOF
+bool receiveFrames(int fd, string &buffer)
+{
+    char chunk[64 * 1024];
+    while (completeFrameSize(buffer.data(), buffer.size()) == 0)
+    {
+        ssize_t n = read(fd, chunk, sizeof(chunk));
+        if (n <= 0)
+            return false;
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+    return true;
+}
+
+void encodeRandomRequest(Writer &writer, mt19937 &rng)
+{
+    size_t start = writer.beginFrame();
+    int task_id = static_cast<int>(rng() % PRELOADED_TASKS) + 1;
+    int pick = static_cast<int>(rng() % 100);
+    if (pick < 60)
+    {
+        writer.u8(static_cast<uint8_t>(Opcode::FIND_TASK));
+        writer.i32(task_id);
+    }
+    else if (pick < 75)
+    {
+        writer.u8(static_cast<uint8_t>(Opcode::AUTOCOMPLETE));
+        writer.str("Load task " + to_string(rng() % 10));
+        writer.u32(10);
+    }
+    else if (pick < 90)
+    {
+        writer.u8(static_cast<uint8_t>(Opcode::UPDATE_STATUS));
+        writer.i32(task_id);
+        writer.u8(static_cast<uint8_t>(rng() % 2));
+    }
+    else
+    {
+        writer.u8(static_cast<uint8_t>(Opcode::GET_COUNT));
+    }
+    writer.endFrame(start);
+}
+
+// Keeps `depth` requests in flight; latencies are appended in microseconds
+bool runConnection(const string &socket_path, long requests, int depth, unsigned seed, vector<double> &latencies)
+{
+    int fd = connectTo(socket_path);
+    if (fd < 0)
+        return false;
+
+    mt19937 rng(seed);
+    deque<Clock::time_point> in_flight;
+    string outgoing, incoming;
+    long sent = 0, received = 0;
+    bool ok = true;
+
+    while (ok && received < requests)
+    {
+        outgoing.clear();
+        Writer writer(outgoing);
+        auto now = Clock::now();
+        while (sent < requests && static_cast<int>(in_flight.size()) < depth)
+        {
+            encodeRandomRequest(writer, rng);
+            in_flight.push_back(now);
+            ++sent;
+        }
+        if (!outgoing.empty() && !sendAll(fd, outgoing))
+            ok = false;
+        if (!ok || !receiveFrames(fd, incoming))
+            break;
+
+        // Consume every response that has fully arrived
+        auto done = Clock::now();
+        size_t offset = 0;
+        for (;;)
+        {
+            size_t frame = completeFrameSize(incoming.data() + offset, incoming.size() - offset);
+            if (frame == 0 || frame == SIZE_MAX)
+            {
+                ok = frame == 0;
+                break;
+            }
+            Reader response(incoming.data() + offset + sizeof(uint32_t), frame - sizeof(uint32_t));
+            if (static_cast<Status>(response.u8()) != Status::OK)
+                ok = false;
+            latencies.push_back(chrono::duration<double, micro>(done - in_flight.front()).count());
+            in_flight.pop_front();
+            ++received;
+            offset += frame;
+        }
+        incoming.erase(0, offset);
+    }
+
+    close(fd);
+    return ok && received == requests;
+}
+
+bool preload(const string &socket_path)
+{
+    int fd = connectTo(socket_path);
+    if (fd < 0)
+        return false;
+
+    string outgoing, incoming;
+    Writer writer(outgoing);
+    size_t start = writer.beginFrame();
+    writer.u8(static_cast<uint8_t>(Opcode::RESET));
+    writer.endFrame(start);
+    for (int i = 1; i <= PRELOADED_TASKS; ++i)
+    {
+        start = writer.beginFrame();
+        writer.u8(static_cast<uint8_t>(Opcode::ADD_TASK));
+        writer.str("Load task " + to_string(i));
+        writer.str("Generated by task_load_client");
+        writer.u8(static_cast<uint8_t>(i % 3));
+        writer.i64(NO_DUE_DATE);
+        writer.endFrame(start);
+    }
+
+    bool ok = sendAll(fd, outgoing);
+    for (int received = 0; ok && received <= PRELOADED_TASKS; ++received)
+    {
+        ok = receiveFrames(fd, incoming);
+        if (ok)
+            incoming.erase(0, completeFrameSize(incoming.data(), incoming.size()));
+    }
+    close(fd);
+    return ok;
+}
+
+double percentile(const vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+    size_t index = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1));
+    return sorted[index];
+}
+}
+
+int main(int argc, char **argv)
+{
+    string socket_path = argc > 1 ? argv[1] : "/tmp/task_manager.sock";
+    int connections = argc > 2 ? atoi(argv[2]) : 4;
+    long requests = argc > 3 ? atol(argv[3]) : 200000;
+    int depth = argc > 4 ? atoi(argv[4]) : 32;
+
+    if (!preload(socket_path))
+    {
+        cout << "Error: Cannot reach server at " << socket_path << endl;
+        return 1;
+    }
+
+    vector<vector<double>> latencies(static_cast<size_t>(connections));
+    vector<char> results(static_cast<size_t>(connections), 0);
+    vector<thread> workers;
+    auto start = Clock::now();
+    for (int c = 0; c < connections; ++c)
+    {
+        workers.emplace_back([&, c]() {
+            results[c] = runConnection(socket_path, requests, depth, static_cast<unsigned>(c + 1), latencies[c]);
+        });
+    }
+    for (auto &worker : workers)
+        worker.join();
+    double elapsed = chrono::duration<double>(Clock::now() - start).count();
+
+    vector<double> all;
+    for (const auto &per_connection : latencies)
+        all.insert(all.end(), per_connection.begin(), per_connection.end());
+    sort(all.begin(), all.end());
+
+    cout << "Connections: " << connections << ", pipeline depth: " << depth << endl;
+    cout << "Requests: " << all.size() << " in " << elapsed << " s ("
+         << static_cast<long>(static_cast<double>(all.size()) / elapsed) << " req/s)" << endl;
+    cout << "Latency us: p50 " << percentile(all, 50) << ", p90 " << percentile(all, 90)
+         << ", p99 " << percentile(all, 99) << ", p99.9 " << percentile(all, 99.9)
+         << ", max " << (all.empty() ? 0 : all.back()) << endl;
+
+    bool ok = all_of(results.begin(), results.end(), [](char r) { return r != 0; });
+    if (!ok)
+        cout << "Error: Some connections failed." << endl;
+    return ok ? 0 : 1;
+}
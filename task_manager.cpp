@@ -1,10 +1,32 @@
 #include "task_manager.h"
+#include <chrono>
+#include <utility>
 using namespace std;
+using task_protocol::Opcode;
 
-TaskManager::TaskManager() : task_counter(0) {}
+namespace
+{
+long long systemClock()
+{
+    return chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count();
+}
+
+uint64_t wheelTime(long long time)
+{
+    return time < 0 ? 0 : static_cast<uint64_t>(time);
+}
+}
+
+TaskManager::TaskManager() : task_counter(0), clock(systemClock), deadlines(wheelTime(clock())) {}
 
 void TaskManager::addTask(const string &title, const string &description, Priority priority)
 {
+    addTask(title, description, priority, NO_DUE_DATE);
+}
+
+void TaskManager::addTask(const string &title, const string &description, Priority priority, long long due_date)
+{
+    trace(Opcode::ADD_TASK, title, description, priority, due_date);
     if (tasks.size() >= MAX_TASKS)
     {
         cout << "Error: Maximum number of tasks reached." << endl;
@@ -17,32 +39,34 @@ void TaskManager::addTask(const string &title, const string &description, Priori
     new_task.description = description;
     new_task.priority = priority;
     new_task.is_completed = false;
+    new_task.due_date = due_date;
 
     tasks.push_back(new_task);
+    dependencies.addNode(new_task.task_id);
+    scheduleDeadline(new_task);
+    title_index.insert(new_task.title, new_task.task_id);
+    publishTask(new_task);
     cout << "Task added successfully." << endl;
 }
 
 Task* TaskManager::findTask(int task_id)
 {
-    for (auto &task : tasks)
-    {
-        if (task.task_id == task_id)
-        {
-            return &task;
-        }
-    }
-    return nullptr;
+    trace(Opcode::FIND_TASK, task_id);
+    return tasks.find(task_id);
 }
 
 void TaskManager::deleteTask(int task_id)
 {
-    auto it = find_if(tasks.begin(), tasks.end(), [task_id](const Task &task) {
-        return task.task_id == task_id;
-    });
+    trace(Opcode::DELETE_TASK, task_id);
+    const Task *task = as_const(tasks).find(task_id);
 
-    if (it != tasks.end())
+    if (task != nullptr)
     {
-        tasks.erase(it);
+        title_index.erase(task->title, task_id);
+        tasks.erase(task_id);
+        dependencies.removeNode(task_id);
+        deadlines.cancel(task_id);
+        unpublishTask(task_id);
         cout << "Task " << task_id << " deleted successfully." << endl;
     }
     else
@@ -53,22 +77,41 @@ void TaskManager::deleteTask(int task_id)
 
 void TaskManager::updateTask(int task_id, const string &new_title, const string &new_description, Priority new_priority)
 {
-    Task *task = findTask(task_id);
+    const Task *task = as_const(tasks).find(task_id);
+    updateTask(task_id, new_title, new_description, new_priority, task == nullptr ? NO_DUE_DATE : task->due_date);
+}
+
+void TaskManager::updateTask(int task_id, const string &new_title, const string &new_description, Priority new_priority, long long new_due_date)
+{
+    trace(Opcode::UPDATE_TASK, task_id, new_title, new_description, new_priority, new_due_date);
+    Task *task = tasks.find(task_id);
     if (task == nullptr)
     {
         cout << "Error: Task not found." << endl;
         return;
     }
 
+    if (task->title != new_title)
+    {
+        title_index.erase(task->title, task_id);
+        title_index.insert(new_title, task_id);
+    }
     task->title = new_title;
     task->description = new_description;
     task->priority = new_priority;
+    if (task->due_date != new_due_date)
+    {
+        task->due_date = new_due_date;
+        scheduleDeadline(*task);
+    }
+    publishTask(*task);
     cout << "Task updated successfully." << endl;
 }
 
 void TaskManager::markTaskCompleted(int task_id)
 {
-    Task *task = findTask(task_id);
+    trace(Opcode::MARK_COMPLETED, task_id);
+    Task *task = tasks.find(task_id);
     if (task == nullptr)
     {
         cout << "Error: Task not found." << endl;
@@ -76,12 +119,16 @@ void TaskManager::markTaskCompleted(int task_id)
     }
 
     task->is_completed = true;
+    dependencies.markCompleted(task_id);
+    deadlines.cancel(task_id);
+    publishTask(*task);
     cout << "Task " << task_id << " marked as completed." << endl;
 }
 
 void TaskManager::displayTaskDetails(int task_id)
 {
-    Task *task = findTask(task_id);
+    trace(Opcode::DISPLAY_TASK_DETAILS, task_id);
+    const Task *task = as_const(tasks).find(task_id);
     if (task == nullptr)
     {
         cout << "Error: Task not found." << endl;
@@ -93,6 +140,10 @@ void TaskManager::displayTaskDetails(int task_id)
     cout << "Description: " << task->description << endl;
     cout << "Priority: " << formatPriority(task->priority) << endl;
     cout << "Status: " << formatStatus(task->is_completed) << endl;
+    if (task->due_date != NO_DUE_DATE)
+    {
+        cout << "Due date: " << task->due_date << endl;
+    }
 }
 
 string TaskManager::formatPriority(Priority priority)
@@ -117,6 +168,7 @@ string TaskManager::formatStatus(bool is_completed)
 
 void TaskManager::displayAllTasks()
 {
+    trace(Opcode::DISPLAY_ALL);
     cout << "List of all tasks:" << endl;
     for (const auto &task : tasks)
     {
@@ -126,6 +178,7 @@ void TaskManager::displayAllTasks()
 
 void TaskManager::displayCompletedTasks()
 {
+    trace(Opcode::DISPLAY_COMPLETED);
     cout << "Completed tasks:" << endl;
     for (const auto &task : tasks)
     {
@@ -138,6 +191,7 @@ void TaskManager::displayCompletedTasks()
 
 void TaskManager::displayIncompleteTasks()
 {
+    trace(Opcode::DISPLAY_INCOMPLETE);
     cout << "Incomplete tasks:" << endl;
     bool found = false;
     for (const auto &task : tasks)
@@ -156,6 +210,7 @@ void TaskManager::displayIncompleteTasks()
 
 void TaskManager::countTasksByStatus()
 {
+    trace(Opcode::COUNT_BY_STATUS);
     int completed = 0, incomplete = 0;
     for (const auto &task : tasks)
     {
@@ -170,16 +225,27 @@ void TaskManager::countTasksByStatus()
 
 void TaskManager::clearCompletedTasks()
 {
-    auto it = remove_if(tasks.begin(), tasks.end(), [](const Task &task) {
+    trace(Opcode::CLEAR_COMPLETED);
+    for (const auto &task : tasks)
+    {
+        if (task.is_completed)
+        {
+            dependencies.removeNode(task.task_id);
+            deadlines.cancel(task.task_id);
+            title_index.erase(task.title, task.task_id);
+            unpublishTask(task.task_id);
+        }
+    }
+    tasks.removeIf([](const Task &task) {
         return task.is_completed;
     });
-    tasks.erase(it, tasks.end());
     cout << "Completed tasks have been cleared." << endl;
 }
 
 void TaskManager::sortTasksByPriority()
 {
-    sort(tasks.begin(), tasks.end(), [](const Task &a, const Task &b) {
+    trace(Opcode::SORT_BY_PRIORITY);
+    tasks.sort([](const Task &a, const Task &b) {
         return static_cast<int>(a.priority) < static_cast<int>(b.priority);
     });
     cout << "Tasks sorted by priority." << endl;
@@ -187,14 +253,23 @@ void TaskManager::sortTasksByPriority()
 
 void TaskManager::resetTasks()
 {
+    trace(Opcode::RESET);
     tasks.clear();
+    dependencies.clear();
+    deadlines.reset(wheelTime(clock()));
+    title_index.clear();
+    if (shared_store)
+    {
+        shared_store->clear();
+    }
     task_counter = 0;
     cout << "All tasks have been reset." << endl;
 }
 
 void TaskManager::updateTaskStatus(int task_id, bool new_status)
 {
-    Task *task = findTask(task_id);
+    trace(Opcode::UPDATE_STATUS, task_id, new_status);
+    Task *task = tasks.find(task_id);
     if (task == nullptr)
     {
         cout << "Error: Task not found." << endl;
@@ -202,11 +277,18 @@ void TaskManager::updateTaskStatus(int task_id, bool new_status)
     }
 
     task->is_completed = new_status;
+    if (new_status)
+        dependencies.markCompleted(task_id);
+    else
+        dependencies.markIncomplete(task_id);
+    scheduleDeadline(*task);
+    publishTask(*task);
     cout << "Task " << task_id << " marked as " << (new_status ? "completed" : "incomplete") << "." << endl;
 }
 
 void TaskManager::displayTasksByPriority()
 {
+    trace(Opcode::DISPLAY_BY_PRIORITY);
     cout << "Tasks grouped by priority:" << endl;
     for (int i = 0; i <= static_cast<int>(Priority::HIGH); ++i)
     {
@@ -230,6 +312,7 @@ void TaskManager::displayTasksByPriority()
 
 void TaskManager::searchTaskByTitle(const string &title)
 {
+    trace(Opcode::SEARCH_TITLE, title);
     cout << "Searching tasks with title containing '" << title << "':" << endl;
     for (const auto &task : tasks)
     {
@@ -240,8 +323,45 @@ void TaskManager::searchTaskByTitle(const string &title)
     }
 }
 
+vector<int> TaskManager::autocompleteTitle(const string &prefix, size_t limit)
+{
+    trace(Opcode::AUTOCOMPLETE, prefix, limit);
+    return title_index.findPrefix(prefix, limit);
+}
+
+void TaskManager::displayTitleSuggestions(const string &prefix, size_t limit)
+{
+    trace(Opcode::DISPLAY_SUGGESTIONS, prefix, limit);
+    cout << "Tasks with title starting with '" << prefix << "':" << endl;
+    for (int task_id : title_index.findPrefix(prefix, limit))
+    {
+        const Task *task = as_const(tasks).find(task_id);
+        if (task == nullptr)
+        {
+            continue;  // stale entry left by a rename through findTask
+        }
+        cout << "Task ID: " << task->task_id << ", Title: " << task->title << endl;
+    }
+}
+
+void TaskManager::setTitleMatchIgnoreCase(bool ignore_case)
+{
+    trace(Opcode::SET_IGNORE_CASE, ignore_case);
+    if (title_index.ignoresCase() == ignore_case)
+    {
+        return;
+    }
+
+    title_index = TitleIndex(ignore_case);
+    for (const auto &task : tasks)
+    {
+        title_index.insert(task.title, task.task_id);
+    }
+}
+
 void TaskManager::searchTaskByDescription(const string &description)
 {
+    trace(Opcode::SEARCH_DESCRIPTION, description);
     cout << "Searching tasks with description containing '" << description << "':" << endl;
     for (const auto &task : tasks)
     {
@@ -254,23 +374,22 @@ void TaskManager::searchTaskByDescription(const string &description)
 
 void TaskManager::displayTaskCount()
 {
+    trace(Opcode::DISPLAY_COUNT);
     cout << "Total number of tasks: " << tasks.size() << endl;
 }
 
 int TaskManager::getTaskCount() {
+    trace(Opcode::GET_COUNT);
     return tasks.size();
 }
 
 Task* TaskManager::searchTaskById(int task_id) {
-    for (auto& task : tasks) {
-        if (task.task_id == task_id) {
-            return &task;
-        }
-    }
-    return nullptr;  // Task not found
+    trace(Opcode::FIND_TASK, task_id);
+    return tasks.find(task_id);  // nullptr if not found
 }
 
 void TaskManager::notifyHighPriorityTasks() {
+    trace(Opcode::NOTIFY_HIGH_PRIORITY);
     for (const auto& task : tasks) {
         if (task.priority == Priority::HIGH) {
             cout << "High-priority task: " << task.title << endl;
@@ -278,7 +397,26 @@ void TaskManager::notifyHighPriorityTasks() {
     }
 }
 
+void TaskManager::notifyOverdueTasks() {
+    trace(Opcode::NOTIFY_OVERDUE);
+    vector<const Task*> overdue;
+    for (int task_id : deadlines.advance(wheelTime(clock()))) {
+        // Completion through a findTask pointer leaves the deadline behind
+        const Task* task = as_const(tasks).find(task_id);
+        if (task != nullptr) {
+            overdue.push_back(task);
+        }
+    }
+    sort(overdue.begin(), overdue.end(), [](const Task* a, const Task* b) {
+        return a->due_date != b->due_date ? a->due_date < b->due_date : a->task_id < b->task_id;
+    });
+    for (const Task* task : overdue) {
+        cout << "Overdue task: " << task->title << endl;
+    }
+}
+
 void TaskManager::countTasksByPriority() {
+    trace(Opcode::COUNT_BY_PRIORITY);
     int low_count = 0, medium_count = 0, high_count = 0;
     for (const auto& task : tasks) {
         switch (task.priority) {
@@ -293,8 +431,263 @@ void TaskManager::countTasksByPriority() {
 }
 
 void TaskManager::sortTasksByTitle() {
-    std::sort(tasks.begin(), tasks.end(), [](const Task& a, const Task& b) {
+    trace(Opcode::SORT_BY_TITLE);
+    tasks.sort([](const Task& a, const Task& b) {
         return a.title < b.title;
     });
     std::cout << "Tasks sorted by title." << std::endl;
+}
+
+void TaskManager::addTaskDependency(int task_id, int prerequisite_id)
+{
+    trace(Opcode::ADD_DEPENDENCY, task_id, prerequisite_id);
+    // The graph holds a node for every task, so it also answers "not found"
+    switch (dependencies.addDependency(task_id, prerequisite_id))
+    {
+    case DependencyResult::ADDED:
+        cout << "Task " << task_id << " now depends on task " << prerequisite_id << "." << endl;
+        break;
+    case DependencyResult::UNKNOWN_TASK:
+        cout << "Error: Task not found." << endl;
+        break;
+    case DependencyResult::ALREADY_EXISTS:
+        cout << "Error: Dependency already exists." << endl;
+        break;
+    case DependencyResult::CYCLE:
+        cout << "Error: Dependency would create a cycle." << endl;
+        break;
+    }
+}
+
+void TaskManager::removeTaskDependency(int task_id, int prerequisite_id)
+{
+    trace(Opcode::REMOVE_DEPENDENCY, task_id, prerequisite_id);
+    if (!dependencies.removeDependency(task_id, prerequisite_id))
+    {
+        cout << "Error: Dependency not found." << endl;
+        return;
+    }
+    cout << "Task " << task_id << " no longer depends on task " << prerequisite_id << "." << endl;
+}
+
+bool TaskManager::isTaskReady(int task_id)
+{
+    trace(Opcode::IS_READY, task_id);
+    return dependencies.isReady(task_id);
+}
+
+std::vector<int> TaskManager::getReadyTasks()
+{
+    trace(Opcode::GET_READY);
+    return dependencies.getReadyNodes();
+}
+
+void TaskManager::displayReadyTasks()
+{
+    trace(Opcode::DISPLAY_READY);
+    cout << "Ready tasks:" << endl;
+    for (int task_id : dependencies.getReadyNodes())
+    {
+        const Task *task = as_const(tasks).find(task_id);
+        if (task == nullptr)
+        {
+            continue;
+        }
+        cout << "Task ID: " << task->task_id << ", Title: " << task->title << endl;
+    }
+}
+
+void TaskManager::setTaskDueDate(int task_id, long long due_date)
+{
+    trace(Opcode::SET_DUE_DATE, task_id, due_date);
+    Task *task = tasks.find(task_id);
+    if (task == nullptr)
+    {
+        cout << "Error: Task not found." << endl;
+        return;
+    }
+
+    task->due_date = due_date;
+    scheduleDeadline(*task);
+    publishTask(*task);
+    cout << "Task " << task_id << " due date updated." << endl;
+}
+
+void TaskManager::setClock(std::function<long long()> new_clock)
+{
+    // The wheel cannot run backwards, so restart it on the new clock
+    clock = new_clock;
+    deadlines.reset(wheelTime(clock()));
+    for (const auto &task : tasks)
+    {
+        scheduleDeadline(task);
+    }
+}
+
+void TaskManager::scheduleDeadline(const Task &task)
+{
+    if (task.due_date == NO_DUE_DATE || task.is_completed)
+    {
+        deadlines.cancel(task.task_id);
+    }
+    else
+    {
+        deadlines.schedule(task.task_id, wheelTime(task.due_date));
+    }
+}
+
+TaskSnapshot TaskManager::snapshot() const
+{
+    return tasks.snapshot();
+}
+
+size_t TaskManager::addTaskBatch(vector<Task> &batch)
+{
+    // Like addTask, without per-task output; ids in the batch are replaced
+    size_t added = 0;
+    for (auto &task : batch)
+    {
+        if (tasks.size() >= MAX_TASKS)
+        {
+            break;
+        }
+
+        // Traced as the addTask/updateTaskStatus calls it is equivalent to
+        task.task_id = ++task_counter;
+        trace(Opcode::ADD_TASK, task.title, task.description, task.priority, task.due_date);
+        if (task.is_completed)
+        {
+            trace(Opcode::UPDATE_STATUS, task.task_id, true);
+        }
+        dependencies.addNode(task.task_id);
+        if (task.is_completed)
+        {
+            dependencies.markCompleted(task.task_id);
+        }
+        scheduleDeadline(task);
+        title_index.insert(task.title, task.task_id);
+        publishTask(task);
+        tasks.push_back(move(task));
+        ++added;
+    }
+    return added;
+}
+
+void TaskManager::importTasks(const string &path, task_io::Format format)
+{
+    size_t added = 0;
+    size_t rejected = 0;
+    task_io::ImportResult result = task_io::importFile(path, format, [&](vector<Task> &batch) {
+        size_t accepted = addTaskBatch(batch);
+        added += accepted;
+        rejected += batch.size() - accepted;
+    });
+
+    if (!result.opened)
+    {
+        cout << "Error: Cannot open " << path << "." << endl;
+        return;
+    }
+    cout << "Imported " << added << " tasks." << endl;
+    if (result.malformed > 0)
+    {
+        cout << "Error: Skipped " << result.malformed << " malformed records." << endl;
+    }
+    if (rejected > 0)
+    {
+        cout << "Error: Maximum number of tasks reached; " << rejected << " tasks not imported." << endl;
+    }
+}
+
+void TaskManager::exportTasks(const string &path, task_io::Format format)
+{
+    long long written = task_io::exportFile(tasks.snapshot(), path, format);
+    if (written < 0)
+    {
+        cout << "Error: Cannot write " << path << "." << endl;
+        return;
+    }
+    cout << "Exported " << written << " tasks." << endl;
+}
+
+bool TaskManager::publishToSharedMemory(const string &name)
+{
+    // The old store unlinks its name when destroyed, so it must go before a
+    // new segment can take the same name
+    shared_store.reset();
+
+    // Room for every task at full length, twice over, before compaction
+    auto store = make_unique<SharedTaskStore>();
+    if (!store->create(name, MAX_TASKS, 2 * MAX_TASKS * (MAX_TITLE_LENGTH + MAX_DESC_LENGTH)))
+    {
+        cout << "Error: Cannot create shared memory segment " << name << "." << endl;
+        return false;
+    }
+
+    shared_store = move(store);
+    for (const auto &task : tasks)
+    {
+        publishTask(task);
+    }
+    cout << "Tasks published to shared memory segment " << name << "." << endl;
+    return true;
+}
+
+void TaskManager::publishTask(const Task &task)
+{
+    if (shared_store && !shared_store->put(task))
+    {
+        cout << "Error: Shared memory segment is full; task " << task.task_id << " is missing from it." << endl;
+    }
+}
+
+void TaskManager::unpublishTask(int task_id)
+{
+    if (shared_store)
+    {
+        shared_store->erase(task_id);
+    }
+}
+
+bool TaskManager::startTrace(const string &path)
+{
+    // Replay starts from a new manager, so ids must not have been issued yet
+    if (!tasks.empty() || task_counter != 0)
+    {
+        cout << "Error: Start tracing on a new or reset manager." << endl;
+        return false;
+    }
+
+    auto trace_recorder = make_unique<task_trace::Recorder>();
+    if (!trace_recorder->open(path))
+    {
+        cout << "Error: Cannot write " << path << "." << endl;
+        return false;
+    }
+
+    recorder = move(trace_recorder);
+    // The only setting that outlives resetTasks, so the replay must know it
+    if (title_index.ignoresCase())
+    {
+        trace(Opcode::SET_IGNORE_CASE, true);
+    }
+    cout << "Recording trace to " << path << "." << endl;
+    return true;
+}
+
+void TaskManager::stopTrace()
+{
+    if (!recorder)
+    {
+        return;
+    }
+
+    bool written = recorder->close();
+    recorder.reset();
+    if (!written)
+    {
+        cout << "Error: Trace could not be written completely." << endl;
+        return;
+    }
+    cout << "Trace recording stopped." << endl;
 }
\ No newline at end of file
@@ -5,28 +5,21 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include "task.h"
+#include "task_graph.h"
+#include "shared_task_store.h"
+#include "task_io.h"
+#include "task_store.h"
+#include "task_trace.h"
+#include "timing_wheel.h"
+#include "title_index.h"
 
 constexpr int MAX_TASKS = 100;
 constexpr int MAX_TITLE_LENGTH = 100;
 constexpr int MAX_DESC_LENGTH = 500;
 
-// Enum for task priority
-enum class Priority {
-    LOW,
-    MEDIUM,
-    HIGH
-};
-
-// Structure to represent a task
-struct Task
-{
-    int task_id;
-    std::string title;
-    std::string description;
-    Priority priority;
-    bool is_completed;
-};
-
 // Class to represent the Task Management System
 class TaskManager
 {
@@ -35,10 +28,12 @@ public:
 
     // Task management functions
     void addTask(const std::string &title, const std::string &description, Priority priority);
+    void addTask(const std::string &title, const std::string &description, Priority priority, long long due_date);
     Task* findTask(int task_id);
     Task* searchTaskById(int task_id);
     void deleteTask(int task_id);
     void updateTask(int task_id, const std::string &new_title, const std::string &new_description, Priority new_priority);
+    void updateTask(int task_id, const std::string &new_title, const std::string &new_description, Priority new_priority, long long new_due_date);
     void markTaskCompleted(int task_id);
     void displayTaskDetails(int task_id);
     void displayAllTasks();
@@ -47,7 +42,12 @@ public:
     void displayTasksByPriority();
     void displayTaskCount();
     int getTaskCount();
+
+    // Point-in-time view of all tasks in O(chunks). Take it on the thread
+    // that writes to the manager; it can then be read from any thread.
+    TaskSnapshot snapshot() const;
     void notifyHighPriorityTasks();
+    void notifyOverdueTasks();
     void countTasksByPriority();
 
     // Additional management utilities
@@ -61,16 +61,70 @@ public:
     void searchTaskByTitle(const std::string &title);
     void searchTaskByDescription(const std::string &description);
 
+    // Title autocomplete (prefix match, ordered by title). Renaming a task
+    // through the pointer returned by findTask bypasses the index, so it can
+    // then return ids of tasks that have since been deleted.
+    std::vector<int> autocompleteTitle(const std::string &prefix, size_t limit);
+    void displayTitleSuggestions(const std::string &prefix, size_t limit);
+    void setTitleMatchIgnoreCase(bool ignore_case);
+
     // Sorting function
     void sortTasksByPriority();
 
+    // Dependency functions
+    void addTaskDependency(int task_id, int prerequisite_id);
+    void removeTaskDependency(int task_id, int prerequisite_id);
+    bool isTaskReady(int task_id);
+    std::vector<int> getReadyTasks();
+    void displayReadyTasks();
+
+    // Deadline functions
+    void setTaskDueDate(int task_id, long long due_date);
+    void setClock(std::function<long long()> new_clock);
+
+    // Bulk load and dump functions
+    size_t addTaskBatch(std::vector<Task> &batch);
+    void importTasks(const std::string &path, task_io::Format format);
+    void exportTasks(const std::string &path, task_io::Format format);
+
+    // Mirrors every change into a shared-memory segment that other processes
+    // can open with SharedTaskReader. Edits made through a pointer returned
+    // by findTask bypass the mirror.
+    bool publishToSharedMemory(const std::string &name);
+
+    // Workload tracing: records every call below that takes part in the
+    // server protocol (see task_trace.h). Start on a new or reset manager, so
+    // the replay issues the same task ids. Edits made through a pointer
+    // returned by findTask are not recorded.
+    bool startTrace(const std::string &path);
+    void stopTrace();
+
     // helper functions
     std::string formatPriority(Priority priority);
     std::string formatStatus(bool is_completed);
 
 private:
-    std::vector<Task> tasks;
+    TaskStore tasks;
     int task_counter; 
+    TaskGraph dependencies;
+    std::function<long long()> clock;
+    TimingWheel deadlines;
+    TitleIndex title_index;
+    std::unique_ptr<SharedTaskStore> shared_store;
+    std::unique_ptr<task_trace::Recorder> recorder;
+
+    void scheduleDeadline(const Task &task);
+    void publishTask(const Task &task);
+    void unpublishTask(int task_id);
+
+    template <typename... Args>
+    void trace(task_protocol::Opcode op, const Args &...args)
+    {
+        if (recorder)
+        {
+            recorder->record(op, args...);
+        }
+    }
 };
 
 #endif
\ No newline at end of file
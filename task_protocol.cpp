@@ -0,0 +1,169 @@
+#include "task_protocol.h"
+
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+namespace task_protocol
+{
+void Writer::raw(const void *data, size_t size)
+{
+    out.append(static_cast<const char *>(data), size);
+}
+
+void Writer::u8(uint8_t value)
+{
+    out.push_back(static_cast<char>(value));
+}
+
+void Writer::u32(uint32_t value)
+{
+    raw(&value, sizeof(value));
+}
+
+void Writer::i32(int32_t value)
+{
+    raw(&value, sizeof(value));
+}
+
+void Writer::i64(int64_t value)
+{
+    raw(&value, sizeof(value));
+}
+
+void Writer::str(string_view value)
+{
+    u32(static_cast<uint32_t>(value.size()));
+    raw(value.data(), value.size());
+}
+
+void Writer::ids(const vector<int> &values)
+{
+    u32(static_cast<uint32_t>(values.size()));
+    for (int value : values)
+    {
+        i32(value);
+    }
+}
+
+void Writer::task(const Task &value)
+{
+    i32(value.task_id);
+    str(value.title);
+    str(value.description);
+    u8(static_cast<uint8_t>(value.priority));
+    u8(value.is_completed ? 1 : 0);
+    i64(value.due_date);
+}
+
+size_t Writer::beginFrame()
+{
+    size_t start = out.size();
+    u32(0);
+    return start;
+}
+
+void Writer::endFrame(size_t start)
+{
+    uint32_t length = static_cast<uint32_t>(out.size() - start - sizeof(uint32_t));
+    memcpy(&out[start], &length, sizeof(length));
+}
+
+bool Reader::raw(void *dest, size_t count)
+{
+    if (failed || size - pos < count)
+    {
+        failed = true;
+        return false;
+    }
+    memcpy(dest, data + pos, count);
+    pos += count;
+    return true;
+}
+
+uint8_t Reader::u8()
+{
+    uint8_t value = 0;
+    raw(&value, sizeof(value));
+    return value;
+}
+
+uint32_t Reader::u32()
+{
+    uint32_t value = 0;
+    raw(&value, sizeof(value));
+    return value;
+}
+
+int32_t Reader::i32()
+{
+    int32_t value = 0;
+    raw(&value, sizeof(value));
+    return value;
+}
+
+int64_t Reader::i64()
+{
+    int64_t value = 0;
+    raw(&value, sizeof(value));
+    return value;
+}
+
+string_view Reader::str()
+{
+    uint32_t length = u32();
+    if (failed || size - pos < length)
+    {
+        failed = true;
+        return string_view();
+    }
+    string_view value(data + pos, length);
+    pos += length;
+    return value;
+}
+
+vector<int> Reader::ids()
+{
+    uint32_t count = u32();
+    vector<int> values;
+    if (failed || (size - pos) / sizeof(int32_t) < count)
+    {
+        failed = true;
+        return values;
+    }
+    values.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        values.push_back(i32());
+    }
+    return values;
+}
+
+Task Reader::task()
+{
+    Task value;
+    value.task_id = i32();
+    value.title = string(str());
+    value.description = string(str());
+    value.priority = static_cast<Priority>(u8());
+    value.is_completed = u8() != 0;
+    value.due_date = i64();
+    return value;
+}
+
+size_t completeFrameSize(const char *data, size_t size)
+{
+    uint32_t length;
+    if (size < sizeof(length))
+    {
+        return 0;
+    }
+    memcpy(&length, data, sizeof(length));
+    if (length > MAX_FRAME_SIZE)
+    {
+        return SIZE_MAX;
+    }
+    return size - sizeof(length) < length ? 0 : sizeof(length) + length;
+}
+}
@@ -0,0 +1,122 @@
+#ifndef TASK_PROTOCOL_H
+#define TASK_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "task.h"
+
+// Binary protocol spoken over the TaskServer's Unix domain socket.
+// Every message is a frame: u32 body length followed by the body. Integers
+// are in host byte order since both ends run on the same machine.
+//
+// Request body:  u8 opcode, then the opcode's arguments.
+// Response body: u8 status, string captured output, then the opcode's result.
+// Strings are a u32 length followed by the bytes. Clients may pipeline any
+// number of requests; responses come back in request order. Frames in both
+// directions are at most MAX_FRAME_SIZE; a call whose response would be
+// larger still runs, but is answered with RESPONSE_TOO_LARGE and no output.
+namespace task_protocol
+{
+constexpr uint32_t MAX_FRAME_SIZE = 1 << 20;
+
+enum class Opcode : uint8_t {
+    ADD_TASK = 1,             // str title, str description, u8 priority, i64 due_date
+    FIND_TASK,                // i32 id -> u8 found [, task]
+    DELETE_TASK,              // i32 id
+    UPDATE_TASK,              // i32 id, str title, str description, u8 priority, i64 due_date
+    MARK_COMPLETED,           // i32 id
+    UPDATE_STATUS,            // i32 id, u8 completed
+    DISPLAY_TASK_DETAILS,     // i32 id
+    DISPLAY_ALL,
+    DISPLAY_COMPLETED,
+    DISPLAY_INCOMPLETE,
+    DISPLAY_BY_PRIORITY,
+    DISPLAY_COUNT,
+    GET_COUNT,                // -> u32 count
+    NOTIFY_HIGH_PRIORITY,
+    NOTIFY_OVERDUE,
+    COUNT_BY_PRIORITY,
+    COUNT_BY_STATUS,
+    CLEAR_COMPLETED,
+    RESET,
+    SORT_BY_TITLE,
+    SORT_BY_PRIORITY,
+    SEARCH_TITLE,             // str text
+    SEARCH_DESCRIPTION,       // str text
+    ADD_DEPENDENCY,           // i32 id, i32 prerequisite
+    REMOVE_DEPENDENCY,        // i32 id, i32 prerequisite
+    IS_READY,                 // i32 id -> u8 ready
+    GET_READY,                // -> id list
+    DISPLAY_READY,
+    SET_DUE_DATE,             // i32 id, i64 due_date
+    AUTOCOMPLETE,             // str prefix, u32 limit -> id list
+    DISPLAY_SUGGESTIONS,      // str prefix, u32 limit
+    SET_IGNORE_CASE           // u8 ignore_case
+};
+
+enum class Status : uint8_t {
+    OK = 0,
+    BAD_REQUEST,
+    UNKNOWN_OPCODE,
+    RESPONSE_TOO_LARGE  // the call ran; its output and result were dropped
+};
+
+// Appends encoded values to a byte buffer
+class Writer
+{
+public:
+    explicit Writer(std::string &out) : out(out) {}
+
+    void u8(uint8_t value);
+    void u32(uint32_t value);
+    void i32(int32_t value);
+    void i64(int64_t value);
+    void str(std::string_view value);
+    void ids(const std::vector<int> &values);
+    void task(const Task &value);
+
+    // Frame helpers: reserve the length prefix, then patch it once the body is written
+    size_t beginFrame();
+    void endFrame(size_t start);
+
+private:
+    void raw(const void *data, size_t size);
+
+    std::string &out;
+};
+
+// Decodes values from a frame body; any overrun sets the failed flag
+class Reader
+{
+public:
+    Reader(const char *data, size_t size) : data(data), size(size), pos(0), failed(false) {}
+
+    uint8_t u8();
+    uint32_t u32();
+    int32_t i32();
+    int64_t i64();
+    std::string_view str();
+    std::vector<int> ids();
+    Task task();
+
+    bool ok() const { return !failed; }
+    bool atEnd() const { return pos == size; }
+
+private:
+    bool raw(void *dest, size_t count);
+
+    const char *data;
+    size_t size;
+    size_t pos;
+    bool failed;
+};
+
+// Returns the total size of the first complete frame in buffer, 0 if more
+// bytes are needed, or SIZE_MAX if the frame is oversized.
+size_t completeFrameSize(const char *data, size_t size);
+}
+
+#endif
@@ -0,0 +1,151 @@
+#include "task_replay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include "task_server.h"
+
+using namespace std;
+using namespace task_protocol;
+using Clock = chrono::steady_clock;
+
+namespace task_replay
+{
+namespace
+{
+constexpr size_t OPCODE_COUNT = 256;
+
+double percentile(const vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+    size_t index = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1));
+    return sorted[index];
+}
+
+LatencyStats summarize(vector<double> &latencies)
+{
+    sort(latencies.begin(), latencies.end());
+    LatencyStats stats;
+    stats.count = latencies.size();
+    stats.p50 = percentile(latencies, 50);
+    stats.p90 = percentile(latencies, 90);
+    stats.p99 = percentile(latencies, 99);
+    stats.p999 = percentile(latencies, 99.9);
+    stats.max = latencies.empty() ? 0 : latencies.back();
+    return stats;
+}
+}
+
+Result replay(const vector<task_trace::Record> &records, TaskManager &manager, const Options &options)
+{
+    // Never started, so it only dispatches; no socket is created
+    TaskServer dispatcher(manager, string());
+    vector<vector<double>> by_op(OPCODE_COUNT);
+    vector<double> all;
+    all.reserve(records.size());
+    string response;
+    Result result;
+
+    auto start = Clock::now();
+    for (const auto &record : records)
+    {
+        Clock::time_point issued = Clock::now();
+        if (options.realtime)
+        {
+            auto offset = chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(record.time_ns) / options.speed));
+            Clock::time_point scheduled = start + chrono::duration_cast<Clock::duration>(offset);
+            if (issued < scheduled)
+                this_thread::sleep_until(scheduled);
+            issued = scheduled;
+        }
+
+        response.clear();
+        size_t consumed = dispatcher.handleRequests(record.frame, record.frame_size, response);
+        double latency = chrono::duration<double, micro>(Clock::now() - issued).count();
+
+        // Byte 4 is the opcode of the request and the status of the response
+        auto op = static_cast<uint8_t>(record.frame_size > sizeof(uint32_t) ? record.frame[sizeof(uint32_t)] : 0);
+        // RESPONSE_TOO_LARGE still ran the call, so it is not a rejection
+        Status status = response.size() > sizeof(uint32_t) ? static_cast<Status>(response[sizeof(uint32_t)])
+                                                            : Status::BAD_REQUEST;
+        if (consumed != record.frame_size || (status != Status::OK && status != Status::RESPONSE_TOO_LARGE))
+            ++result.rejected;
+        by_op[op].push_back(latency);
+        all.push_back(latency);
+    }
+    result.seconds = chrono::duration<double>(Clock::now() - start).count();
+    result.operations = records.size();
+
+    result.overall = summarize(all);
+    for (size_t op = 0; op < OPCODE_COUNT; ++op)
+    {
+        if (!by_op[op].empty())
+            result.per_op.emplace_back(static_cast<Opcode>(op), summarize(by_op[op]));
+    }
+    result.checksum = stateChecksum(manager);
+    return result;
+}
+
+uint64_t stateChecksum(TaskManager &manager)
+{
+    string encoded;
+    Writer writer(encoded);
+    for (const auto &task : manager.snapshot())
+    {
+        writer.task(task);
+    }
+    vector<int> ready = manager.getReadyTasks();
+    sort(ready.begin(), ready.end());
+    writer.ids(ready);
+
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : encoded)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+const char* opcodeName(Opcode op)
+{
+    switch (op)
+    {
+    case Opcode::ADD_TASK: return "ADD_TASK";
+    case Opcode::FIND_TASK: return "FIND_TASK";
+    case Opcode::DELETE_TASK: return "DELETE_TASK";
+    case Opcode::UPDATE_TASK: return "UPDATE_TASK";
+    case Opcode::MARK_COMPLETED: return "MARK_COMPLETED";
+    case Opcode::UPDATE_STATUS: return "UPDATE_STATUS";
+    case Opcode::DISPLAY_TASK_DETAILS: return "DISPLAY_TASK_DETAILS";
+    case Opcode::DISPLAY_ALL: return "DISPLAY_ALL";
+    case Opcode::DISPLAY_COMPLETED: return "DISPLAY_COMPLETED";
+    case Opcode::DISPLAY_INCOMPLETE: return "DISPLAY_INCOMPLETE";
+    case Opcode::DISPLAY_BY_PRIORITY: return "DISPLAY_BY_PRIORITY";
+    case Opcode::DISPLAY_COUNT: return "DISPLAY_COUNT";
+    case Opcode::GET_COUNT: return "GET_COUNT";
+    case Opcode::NOTIFY_HIGH_PRIORITY: return "NOTIFY_HIGH_PRIORITY";
+    case Opcode::NOTIFY_OVERDUE: return "NOTIFY_OVERDUE";
+    case Opcode::COUNT_BY_PRIORITY: return "COUNT_BY_PRIORITY";
+    case Opcode::COUNT_BY_STATUS: return "COUNT_BY_STATUS";
+    case Opcode::CLEAR_COMPLETED: return "CLEAR_COMPLETED";
+    case Opcode::RESET: return "RESET";
+    case Opcode::SORT_BY_TITLE: return "SORT_BY_TITLE";
+    case Opcode::SORT_BY_PRIORITY: return "SORT_BY_PRIORITY";
+    case Opcode::SEARCH_TITLE: return "SEARCH_TITLE";
+    case Opcode::SEARCH_DESCRIPTION: return "SEARCH_DESCRIPTION";
+    case Opcode::ADD_DEPENDENCY: return "ADD_DEPENDENCY";
+    case Opcode::REMOVE_DEPENDENCY: return "REMOVE_DEPENDENCY";
+    case Opcode::IS_READY: return "IS_READY";
+    case Opcode::GET_READY: return "GET_READY";
+    case Opcode::DISPLAY_READY: return "DISPLAY_READY";
+    case Opcode::SET_DUE_DATE: return "SET_DUE_DATE";
+    case Opcode::AUTOCOMPLETE: return "AUTOCOMPLETE";
+    case Opcode::DISPLAY_SUGGESTIONS: return "DISPLAY_SUGGESTIONS";
+    case Opcode::SET_IGNORE_CASE: return "SET_IGNORE_CASE";
+    default: return "UNKNOWN";
+    }
+}
+}
@@ -0,0 +1,50 @@
+#ifndef TASK_REPLAY_H
+#define TASK_REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "task_manager.h"
+#include "task_protocol.h"
+#include "task_trace.h"
+
+// Deterministic replay of a recorded trace against a TaskManager.
+// Each record is dispatched exactly as a TaskServer would dispatch the same
+// request, so two builds fed the same trace must end in the same state.
+namespace task_replay
+{
+struct Options
+{
+    bool realtime = false;  // open loop at the recorded timing instead of back to back
+    double speed = 1.0;     // realtime only: >1 compresses the recorded gaps
+};
+
+// Microseconds. In realtime mode latency runs from the recorded start time,
+// so a replay that falls behind reports its queueing delay too.
+struct LatencyStats
+{
+    size_t count = 0;
+    double p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+};
+
+struct Result
+{
+    size_t operations = 0;
+    size_t rejected = 0;  // records the server protocol refused
+    double seconds = 0;
+    LatencyStats overall;
+    std::vector<std::pair<task_protocol::Opcode, LatencyStats>> per_op;  // by opcode
+    uint64_t checksum = 0;  // stateChecksum after the last record
+};
+
+Result replay(const std::vector<task_trace::Record> &records, TaskManager &manager,
+              const Options &options = Options());
+
+// FNV-1a over every task in store order plus the sorted ready set
+uint64_t stateChecksum(TaskManager &manager);
+
+const char* opcodeName(task_protocol::Opcode op);
+}
+
+#endif
@@ -0,0 +1,461 @@
+#include "task_server.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace task_protocol;
+
+namespace
+{
+constexpr size_t READ_CHUNK = 64 * 1024;
+constexpr int MAX_EVENTS = 64;
+// Always holds at least one whole frame, so a full buffer can make progress
+constexpr size_t INPUT_LIMIT = MAX_FRAME_SIZE + sizeof(uint32_t);
+
+bool validPriority(uint8_t priority)
+{
+    return priority <= static_cast<uint8_t>(Priority::HIGH);
+}
+}
+
+TaskServer::TaskServer(TaskManager &manager, const string &socket_path)
+    : manager(manager), socket_path(socket_path), listen_fd(-1), epoll_fd(-1), stop_fd(-1) {}
+
+TaskServer::~TaskServer()
+{
+    for (const auto &entry : connections)
+    {
+        close(entry.first);
+    }
+    if (listen_fd >= 0)
+    {
+        close(listen_fd);
+        unlink(socket_path.c_str());
+    }
+    if (epoll_fd >= 0)
+        close(epoll_fd);
+    if (stop_fd >= 0)
+        close(stop_fd);
+}
+
+bool TaskServer::start()
+{
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(addr.sun_path))
+    {
+        cout << "Error: Socket path too long." << endl;
+        return false;
+    }
+    strcpy(addr.sun_path, socket_path.c_str());
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    unlink(socket_path.c_str());
+    if (listen_fd < 0 || bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        listen(listen_fd, SOMAXCONN) != 0)
+    {
+        cout << "Error: Cannot listen on " << socket_path << ": " << strerror(errno) << endl;
+        return false;
+    }
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd < 0 || stop_fd < 0)
+    {
+        cout << "Error: Cannot create event loop: " << strerror(errno) << endl;
+        return false;
+    }
+
+    epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = listen_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &ev);
+    ev.data.fd = stop_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, stop_fd, &ev);
+    return true;
+}
+
+void TaskServer::stop()
+{
+    uint64_t one = 1;
+    if (stop_fd >= 0 && write(stop_fd, &one, sizeof(one)) < 0)
+    {
+        // Nothing useful to do; the loop keeps running
+    }
+}
+
+void TaskServer::run()
+{
+    epoll_event events[MAX_EVENTS];
+    for (;;)
+    {
+        int ready = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            cout << "Error: epoll_wait failed: " << strerror(errno) << endl;
+            return;
+        }
+
+        for (int i = 0; i < ready; ++i)
+        {
+            int fd = events[i].data.fd;
+            if (fd == stop_fd)
+            {
+                return;
+            }
+            if (fd == listen_fd)
+            {
+                acceptConnections();
+                continue;
+            }
+
+            auto it = connections.find(fd);
+            if (it == connections.end())
+                continue;
+
+            Connection &conn = it->second;
+            bool alive = !(events[i].events & (EPOLLERR | EPOLLHUP)) || (events[i].events & EPOLLIN);
+            if (alive && (events[i].events & EPOLLIN) && conn.want_read)
+                alive = readFrom(fd, conn);
+            if (alive)
+                alive = serve(fd, conn);
+            if (!alive)
+                closeConnection(fd);
+        }
+    }
+}
+
+void TaskServer::acceptConnections()
+{
+    for (;;)
+    {
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            return;
+        }
+
+        epoll_event ev;
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.fd = fd;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0)
+        {
+            close(fd);
+            continue;
+        }
+        connections[fd];
+    }
+}
+
+// Reads until the socket is drained or the input buffer is full
+bool TaskServer::readFrom(int fd, Connection &conn)
+{
+    while (conn.input.size() < INPUT_LIMIT)
+    {
+        size_t old_size = conn.input.size();
+        conn.input.resize(old_size + READ_CHUNK);
+        ssize_t n = read(fd, &conn.input[old_size], READ_CHUNK);
+        conn.input.resize(old_size + (n > 0 ? static_cast<size_t>(n) : 0));
+        if (n > 0)
+            continue;
+        if (n == 0)
+            conn.peer_closed = true;
+        else if (errno == EINTR)
+            continue;
+        else if (errno != EAGAIN && errno != EWOULDBLOCK)
+            return false;
+        break;
+    }
+    return true;
+}
+
+// Alternates between running buffered requests and sending responses until
+// neither can make progress. Requests only run while less than
+// OUTPUT_HIGH_WATER bytes of responses are waiting to be sent.
+bool TaskServer::serve(int fd, Connection &conn)
+{
+    for (;;)
+    {
+        bool throttled = conn.output.size() - conn.output_sent >= OUTPUT_HIGH_WATER;
+        size_t consumed = 0;
+        if (!throttled)
+        {
+            consumed = handleRequests(conn.input.data(), conn.input.size(), conn.output,
+                                      conn.output_sent + OUTPUT_HIGH_WATER);
+            if (consumed == SIZE_MAX)
+                return false;
+            conn.input.erase(0, consumed);
+        }
+        if (!flush(fd, conn))
+            return false;
+        // Stop when the socket is full (EPOLLOUT resumes us) or nothing ran
+        if (conn.output_sent < conn.output.size() || (!throttled && consumed == 0))
+            break;
+    }
+
+    // After EOF, close once every complete request has been answered
+    if (conn.peer_closed && conn.output.empty() && completeFrameSize(conn.input.data(), conn.input.size()) == 0)
+        return false;
+    updateInterest(fd, conn);
+    return true;
+}
+
+bool TaskServer::flush(int fd, Connection &conn)
+{
+    while (conn.output_sent < conn.output.size())
+    {
+        ssize_t n = send(fd, conn.output.data() + conn.output_sent, conn.output.size() - conn.output_sent, MSG_NOSIGNAL);
+        if (n > 0)
+        {
+            conn.output_sent += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        return false;
+    }
+
+    // Drop the sent prefix so a slow reader cannot grow the buffer forever
+    if (conn.output_sent == conn.output.size() || conn.output_sent >= OUTPUT_HIGH_WATER)
+    {
+        conn.output.erase(0, conn.output_sent);
+        conn.output_sent = 0;
+    }
+    return true;
+}
+
+void TaskServer::updateInterest(int fd, Connection &conn)
+{
+    bool want_write = conn.output_sent < conn.output.size();
+    bool want_read = !conn.peer_closed && conn.input.size() < INPUT_LIMIT &&
+                     conn.output.size() - conn.output_sent < OUTPUT_HIGH_WATER;
+    if (want_read == conn.want_read && want_write == conn.want_write)
+        return;
+
+    epoll_event ev;
+    ev.events = (want_read ? static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP) : 0u) |
+                (want_write ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    ev.data.fd = fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &ev);
+    conn.want_read = want_read;
+    conn.want_write = want_write;
+}
+
+void TaskServer::closeConnection(int fd)
+{
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections.erase(fd);
+}
+
+size_t TaskServer::handleRequests(const char *data, size_t size, string &output, size_t output_limit)
+{
+    size_t consumed = 0;
+    string result;
+    Writer response(output);
+    streambuf *old_cout = cout.rdbuf(&captured_output);
+
+    while (output.size() < output_limit)
+    {
+        size_t frame = completeFrameSize(data + consumed, size - consumed);
+        if (frame == 0)
+            break;
+        if (frame == SIZE_MAX)
+        {
+            consumed = SIZE_MAX;
+            break;
+        }
+
+        Reader request(data + consumed + sizeof(uint32_t), frame - sizeof(uint32_t));
+        Writer result_writer(result);
+        result.clear();
+        captured_output.str(string());
+
+        Status status = execute(request, result_writer);
+        string text = captured_output.str();
+        size_t body_size = sizeof(uint8_t) + sizeof(uint32_t) + text.size() + result.size();
+        if (status == Status::OK && body_size > MAX_FRAME_SIZE)
+            status = Status::RESPONSE_TOO_LARGE;
+        if (status != Status::OK)
+        {
+            result.clear();
+            text.clear();
+        }
+
+        size_t start = response.beginFrame();
+        response.u8(static_cast<uint8_t>(status));
+        response.str(text);
+        output += result;
+        response.endFrame(start);
+        consumed += frame;
+    }
+
+    cout.rdbuf(old_cout);
+    return consumed;
+}
+
+Status TaskServer::execute(Reader &request, Writer &result)
+{
+    auto op = static_cast<Opcode>(request.u8());
+    if (!request.ok())
+        return Status::BAD_REQUEST;
+    if (op < Opcode::ADD_TASK || op > Opcode::SET_IGNORE_CASE)
+        return Status::UNKNOWN_OPCODE;
+
+    // Arguments are decoded first; nothing runs unless the whole body parsed
+    auto valid = [&request]() { return request.ok() && request.atEnd(); };
+
+    switch (op)
+    {
+    case Opcode::ADD_TASK:
+    case Opcode::UPDATE_TASK:
+    {
+        int32_t task_id = op == Opcode::UPDATE_TASK ? request.i32() : 0;
+        string title(request.str());
+        string description(request.str());
+        uint8_t priority = request.u8();
+        int64_t due_date = request.i64();
+        if (!valid() || !validPriority(priority))
+            return Status::BAD_REQUEST;
+        if (op == Opcode::ADD_TASK)
+            manager.addTask(title, description, static_cast<Priority>(priority), due_date);
+        else
+            manager.updateTask(task_id, title, description, static_cast<Priority>(priority), due_date);
+        return Status::OK;
+    }
+    case Opcode::FIND_TASK:
+    {
+        int32_t task_id = request.i32();
+        if (!valid())
+            return Status::BAD_REQUEST;
+        Task *task = manager.findTask(task_id);
+        result.u8(task != nullptr ? 1 : 0);
+        if (task != nullptr)
+            result.task(*task);
+        return Status::OK;
+    }
+    case Opcode::DELETE_TASK:
+    case Opcode::MARK_COMPLETED:
+    case Opcode::DISPLAY_TASK_DETAILS:
+    case Opcode::IS_READY:
+    {
+        int32_t task_id = request.i32();
+        if (!valid())
+            return Status::BAD_REQUEST;
+        if (op == Opcode::DELETE_TASK)
+            manager.deleteTask(task_id);
+        else if (op == Opcode::MARK_COMPLETED)
+            manager.markTaskCompleted(task_id);
+        else if (op == Opcode::DISPLAY_TASK_DETAILS)
+            manager.displayTaskDetails(task_id);
+        else
+            result.u8(manager.isTaskReady(task_id) ? 1 : 0);
+        return Status::OK;
+    }
+    case Opcode::UPDATE_STATUS:
+    {
+        int32_t task_id = request.i32();
+        uint8_t completed = request.u8();
+        if (!valid())
+            return Status::BAD_REQUEST;
+        manager.updateTaskStatus(task_id, completed != 0);
+        return Status::OK;
+    }
+    case Opcode::ADD_DEPENDENCY:
+    case Opcode::REMOVE_DEPENDENCY:
+    {
+        int32_t task_id = request.i32();
+        int32_t prerequisite_id = request.i32();
+        if (!valid())
+            return Status::BAD_REQUEST;
+        if (op == Opcode::ADD_DEPENDENCY)
+            manager.addTaskDependency(task_id, prerequisite_id);
+        else
+            manager.removeTaskDependency(task_id, prerequisite_id);
+        return Status::OK;
+    }
+    case Opcode::SET_DUE_DATE:
+    {
+        int32_t task_id = request.i32();
+        int64_t due_date = request.i64();
+        if (!valid())
+            return Status::BAD_REQUEST;
+        manager.setTaskDueDate(task_id, due_date);
+        return Status::OK;
+    }
+    case Opcode::SEARCH_TITLE:
+    case Opcode::SEARCH_DESCRIPTION:
+    {
+        string text(request.str());
+        if (!valid())
+            return Status::BAD_REQUEST;
+        if (op == Opcode::SEARCH_TITLE)
+            manager.searchTaskByTitle(text);
+        else
+            manager.searchTaskByDescription(text);
+        return Status::OK;
+    }
+    case Opcode::AUTOCOMPLETE:
+    case Opcode::DISPLAY_SUGGESTIONS:
+    {
+        string prefix(request.str());
+        uint32_t limit = request.u32();
+        if (!valid())
+            return Status::BAD_REQUEST;
+        if (op == Opcode::AUTOCOMPLETE)
+            result.ids(manager.autocompleteTitle(prefix, limit));
+        else
+            manager.displayTitleSuggestions(prefix, limit);
+        return Status::OK;
+    }
+    case Opcode::SET_IGNORE_CASE:
+    {
+        uint8_t ignore_case = request.u8();
+        if (!valid())
+            return Status::BAD_REQUEST;
+        manager.setTitleMatchIgnoreCase(ignore_case != 0);
+        return Status::OK;
+    }
+    default:
+        break;
+    }
+
+    // The remaining operations take no arguments
+    if (!valid())
+        return Status::BAD_REQUEST;
+
+    switch (op)
+    {
+    case Opcode::DISPLAY_ALL: manager.displayAllTasks(); break;
+    case Opcode::DISPLAY_COMPLETED: manager.displayCompletedTasks(); break;
+    case Opcode::DISPLAY_INCOMPLETE: manager.displayIncompleteTasks(); break;
+    case Opcode::DISPLAY_BY_PRIORITY: manager.displayTasksByPriority(); break;
+    case Opcode::DISPLAY_COUNT: manager.displayTaskCount(); break;
+    case Opcode::GET_COUNT: result.u32(static_cast<uint32_t>(manager.getTaskCount())); break;
+    case Opcode::NOTIFY_HIGH_PRIORITY: manager.notifyHighPriorityTasks(); break;
+    case Opcode::NOTIFY_OVERDUE: manager.notifyOverdueTasks(); break;
+    case Opcode::COUNT_BY_PRIORITY: manager.countTasksByPriority(); break;
+    case Opcode::COUNT_BY_STATUS: manager.countTasksByStatus(); break;
+    case Opcode::CLEAR_COMPLETED: manager.clearCompletedTasks(); break;
+    case Opcode::RESET: manager.resetTasks(); break;
+    case Opcode::SORT_BY_TITLE: manager.sortTasksByTitle(); break;
+    case Opcode::SORT_BY_PRIORITY: manager.sortTasksByPriority(); break;
+    case Opcode::GET_READY: result.ids(manager.getReadyTasks()); break;
+    case Opcode::DISPLAY_READY: manager.displayReadyTasks(); break;
+    default: return Status::UNKNOWN_OPCODE;
+    }
+    return Status::OK;
+}
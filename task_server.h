@@ -0,0 +1,66 @@
+#ifndef TASK_SERVER_H
+#define TASK_SERVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include "task_manager.h"
+#include "task_protocol.h"
+
+// Serves one TaskManager to local processes over a Unix domain socket.
+// A single epoll thread owns the manager. Each read pulls in every pipelined
+// request the client has sent, runs them in order, and writes all of their
+// responses back with one send. Output that a call prints to std::cout is
+// captured and returned in its response. A client that stops reading stops
+// being served once OUTPUT_HIGH_WATER bytes of responses are queued for it;
+// after it half-closes, the server finishes its requests and responses
+// before closing.
+class TaskServer
+{
+public:
+    TaskServer(TaskManager &manager, const std::string &socket_path);
+    ~TaskServer();
+
+    bool start();
+    void run();
+    void stop();  // safe to call from another thread or a signal handler
+
+    static constexpr size_t OUTPUT_HIGH_WATER = 1 << 20;
+
+    // Runs every complete request frame at the start of data and appends the
+    // responses to output, stopping early once output holds output_limit
+    // bytes. Returns the bytes consumed, or SIZE_MAX if the input is not a
+    // valid frame stream.
+    size_t handleRequests(const char *data, size_t size, std::string &output, size_t output_limit = SIZE_MAX);
+
+private:
+    struct Connection
+    {
+        std::string input;
+        std::string output;
+        size_t output_sent = 0;
+        bool peer_closed = false;  // read side hit EOF
+        bool want_read = true;     // registered interest, mirrors epoll
+        bool want_write = false;
+    };
+
+    task_protocol::Status execute(task_protocol::Reader &request, task_protocol::Writer &result);
+    void acceptConnections();
+    bool readFrom(int fd, Connection &conn);
+    bool serve(int fd, Connection &conn);
+    bool flush(int fd, Connection &conn);
+    void updateInterest(int fd, Connection &conn);
+    void closeConnection(int fd);
+
+    TaskManager &manager;
+    std::string socket_path;
+    int listen_fd;
+    int epoll_fd;
+    int stop_fd;
+    std::unordered_map<int, Connection> connections;
+    std::stringbuf captured_output;
+};
+
+#endif
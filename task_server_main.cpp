@@ -0,0 +1,40 @@
+// Runs a shared TaskManager behind a Unix domain socket.
+// Build: g++ -O2 -std=c++17 task_server_main.cpp task_server.cpp task_protocol.cpp task_manager.cpp
+//        task_graph.cpp task_io.cpp task_store.cpp timing_wheel.cpp title_index.cpp shared_task_store.cpp
+//        task_trace.cpp -pthread -lrt -o task_server
+// Usage: ./task_server [socket_path] [trace_file]
+#include "task_server.h"
+#include <csignal>
+
+namespace
+{
+TaskServer *running_server = nullptr;
+
+void handleSignal(int)
+{
+    if (running_server != nullptr)
+        running_server->stop();
+}
+}
+
+int main(int argc, char **argv)
+{
+    std::string socket_path = argc > 1 ? argv[1] : "/tmp/task_manager.sock";
+
+    TaskManager task_manager;
+    if (argc > 2 && !task_manager.startTrace(argv[2]))
+        return 1;
+    TaskServer server(task_manager, socket_path);
+    if (!server.start())
+        return 1;
+
+    running_server = &server;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::cout << "Serving tasks on " << socket_path << std::endl;
+    server.run();
+    running_server = nullptr;
+    task_manager.stopTrace();
+    return 0;
+}
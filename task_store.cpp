@@ -0,0 +1,138 @@
+#include "task_store.h"
+
+#include <atomic>
+
+using namespace std;
+
+const Task* TaskSnapshot::find(int task_id) const
+{
+    for (const auto &task : *this)
+    {
+        if (task.task_id == task_id)
+        {
+            return &task;
+        }
+    }
+    return nullptr;
+}
+
+// Returns a chunk that no snapshot shares, copying it if needed
+TaskStore::Chunk& TaskStore::mutableChunk(size_t index)
+{
+    shared_ptr<Chunk> &chunk = chunks[index];
+    if (chunk.use_count() != 1)
+    {
+        chunk = make_shared<Chunk>(*chunk);
+    }
+    // Pairs with the release in a snapshot's final shared_ptr decrement, so
+    // its reads of this chunk happen before our writes
+    atomic_thread_fence(memory_order_acquire);
+    return *chunk;
+}
+
+void TaskStore::push_back(const Task &task)
+{
+    push_back(Task(task));
+}
+
+void TaskStore::push_back(Task &&task)
+{
+    if (chunks.empty() || chunks.back()->size() >= CHUNK_SIZE)
+    {
+        auto chunk = make_shared<Chunk>();
+        chunk->reserve(CHUNK_SIZE);
+        chunks.push_back(move(chunk));
+    }
+    mutableChunk(chunks.size() - 1).push_back(move(task));
+    ++count;
+}
+
+Task* TaskStore::find(int task_id)
+{
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        const Chunk &chunk = *chunks[i];
+        for (size_t j = 0; j < chunk.size(); ++j)
+        {
+            if (chunk[j].task_id == task_id)
+            {
+                return &mutableChunk(i)[j];
+            }
+        }
+    }
+    return nullptr;
+}
+
+const Task* TaskStore::find(int task_id) const
+{
+    for (const auto &task : *this)
+    {
+        if (task.task_id == task_id)
+        {
+            return &task;
+        }
+    }
+    return nullptr;
+}
+
+bool TaskStore::erase(int task_id)
+{
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        const Chunk &chunk = *chunks[i];
+        for (size_t j = 0; j < chunk.size(); ++j)
+        {
+            if (chunk[j].task_id != task_id)
+            {
+                continue;
+            }
+
+            // Iteration relies on there being no empty chunks
+            if (chunk.size() == 1)
+            {
+                chunks.erase(chunks.begin() + i);
+            }
+            else
+            {
+                Chunk &owned = mutableChunk(i);
+                owned.erase(owned.begin() + j);
+            }
+            --count;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskStore::clear()
+{
+    chunks.clear();
+    count = 0;
+}
+
+TaskSnapshot TaskStore::snapshot() const
+{
+    TaskSnapshot view;
+    view.chunks = chunks;
+    view.count = count;
+    return view;
+}
+
+vector<Task> TaskStore::collect() const
+{
+    return vector<Task>(begin(), end());
+}
+
+void TaskStore::rebuild(vector<Task> &&all)
+{
+    chunks.clear();
+    count = all.size();
+    for (size_t i = 0; i < all.size(); i += CHUNK_SIZE)
+    {
+        auto first = all.begin() + i;
+        auto last = all.size() - i > CHUNK_SIZE ? first + CHUNK_SIZE : all.end();
+        auto chunk = make_shared<Chunk>(make_move_iterator(first), make_move_iterator(last));
+        chunk->reserve(CHUNK_SIZE);
+        chunks.push_back(move(chunk));
+    }
+}
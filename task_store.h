@@ -0,0 +1,146 @@
+#ifndef TASK_STORE_H
+#define TASK_STORE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "task.h"
+
+// Read-only iterator over a list of task chunks
+class TaskChunkIterator
+{
+public:
+    using Chunk = std::vector<Task>;
+    using ChunkList = std::vector<std::shared_ptr<Chunk>>;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Task;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Task*;
+    using reference = const Task&;
+
+    TaskChunkIterator(const ChunkList *chunks, size_t chunk, size_t offset)
+        : chunks(chunks), chunk(chunk), offset(offset) {}
+
+    reference operator*() const { return (*(*chunks)[chunk])[offset]; }
+    pointer operator->() const { return &**this; }
+
+    TaskChunkIterator& operator++()
+    {
+        if (++offset == (*chunks)[chunk]->size())
+        {
+            ++chunk;
+            offset = 0;
+        }
+        return *this;
+    }
+
+    TaskChunkIterator operator++(int)
+    {
+        TaskChunkIterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    bool operator==(const TaskChunkIterator &other) const { return chunk == other.chunk && offset == other.offset; }
+    bool operator!=(const TaskChunkIterator &other) const { return !(*this == other); }
+
+private:
+    const ChunkList *chunks;
+    size_t chunk;
+    size_t offset;
+};
+
+// Point-in-time view of a TaskStore.
+// Holds references to the store's chunks at the moment it was taken; the
+// store copies a chunk before writing to it while any snapshot shares it, so
+// a snapshot never observes later writes. Chunks are freed once neither the
+// store nor any snapshot references them. A snapshot may be read from another
+// thread while the owning TaskManager keeps writing.
+class TaskSnapshot
+{
+public:
+    using const_iterator = TaskChunkIterator;
+
+    TaskSnapshot() : count(0) {}
+
+    const_iterator begin() const { return const_iterator(&chunks, 0, 0); }
+    const_iterator end() const { return const_iterator(&chunks, chunks.size(), 0); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Task* find(int task_id) const;
+
+private:
+    friend class TaskStore;
+
+    TaskChunkIterator::ChunkList chunks;
+    size_t count;
+};
+
+// Task container stored as fixed-capacity copy-on-write chunks.
+// Iterators are invalidated by any write; use snapshot() for a stable view.
+class TaskStore
+{
+public:
+    using Chunk = TaskChunkIterator::Chunk;
+    using const_iterator = TaskChunkIterator;
+
+    static constexpr size_t CHUNK_SIZE = 64;
+
+    TaskStore() : count(0) {}
+
+    const_iterator begin() const { return const_iterator(&chunks, 0, 0); }
+    const_iterator end() const { return const_iterator(&chunks, chunks.size(), 0); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    void push_back(const Task &task);
+    void push_back(Task &&task);
+    Task* find(int task_id);  // makes the containing chunk private to the store
+    const Task* find(int task_id) const;
+    bool erase(int task_id);
+    void clear();
+
+    template <typename Predicate>
+    size_t removeIf(Predicate pred);
+
+    template <typename Compare>
+    void sort(Compare comp);
+
+    // O(number of chunks)
+    TaskSnapshot snapshot() const;
+
+private:
+    Chunk& mutableChunk(size_t index);
+    std::vector<Task> collect() const;
+    void rebuild(std::vector<Task> &&all);
+
+    TaskChunkIterator::ChunkList chunks;
+    size_t count;
+};
+
+template <typename Predicate>
+size_t TaskStore::removeIf(Predicate pred)
+{
+    std::vector<Task> all = collect();
+    auto it = std::remove_if(all.begin(), all.end(), pred);
+    size_t removed = static_cast<size_t>(all.end() - it);
+    if (removed != 0)
+    {
+        all.erase(it, all.end());
+        rebuild(std::move(all));
+    }
+    return removed;
+}
+
+template <typename Compare>
+void TaskStore::sort(Compare comp)
+{
+    std::vector<Task> all = collect();
+    std::sort(all.begin(), all.end(), comp);
+    rebuild(std::move(all));
+}
+
+#endif
@@ -0,0 +1,110 @@
+#include "task_trace.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace task_trace
+{
+namespace
+{
+constexpr size_t FLUSH_SIZE = 1 << 20;
+}
+
+Recorder::Recorder() : file(nullptr), failed(false), writer(buffer) {}
+
+Recorder::~Recorder()
+{
+    close();
+}
+
+bool Recorder::open(const string &path)
+{
+    close();
+    file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    failed = false;
+    buffer.clear();
+    buffer.reserve(FLUSH_SIZE + 4096);
+    buffer.append(MAGIC, sizeof(MAGIC));
+    started = chrono::steady_clock::now();
+    return true;
+}
+
+bool Recorder::close()
+{
+    if (file == nullptr)
+        return !failed;
+
+    failed = failed || fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size();
+    failed = fclose(file) != 0 || failed;
+    file = nullptr;
+    buffer.clear();
+    return !failed;
+}
+
+size_t Recorder::beginRecord(task_protocol::Opcode op)
+{
+    auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - started);
+    writer.i64(elapsed.count());
+    size_t start = writer.beginFrame();
+    writer.u8(static_cast<uint8_t>(op));
+    return start;
+}
+
+void Recorder::endRecord(size_t start)
+{
+    writer.endFrame(start);
+    if (buffer.size() >= FLUSH_SIZE)
+    {
+        failed = failed || fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size();
+        buffer.clear();
+    }
+}
+
+bool parse(const string &data, vector<Record> &records)
+{
+    records.clear();
+    if (data.size() < sizeof(MAGIC) || memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0)
+        return false;
+
+    size_t pos = sizeof(MAGIC);
+    while (pos < data.size())
+    {
+        Record record;
+        if (data.size() - pos < sizeof(int64_t))
+            return false;
+        memcpy(&record.time_ns, data.data() + pos, sizeof(int64_t));
+        pos += sizeof(int64_t);
+
+        size_t frame = task_protocol::completeFrameSize(data.data() + pos, data.size() - pos);
+        if (frame == 0 || frame == SIZE_MAX)
+            return false;
+        record.frame = data.data() + pos;
+        record.frame_size = frame;
+        records.push_back(record);
+        pos += frame;
+    }
+    return true;
+}
+
+bool readFile(const string &path, string &data)
+{
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    data.clear();
+    char chunk[1 << 16];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        data.append(chunk, got);
+    }
+    bool ok = ferror(file) == 0;
+    fclose(file);
+    return ok;
+}
+}
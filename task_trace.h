@@ -0,0 +1,76 @@
+#ifndef TASK_TRACE_H
+#define TASK_TRACE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "task.h"
+#include "task_protocol.h"
+
+// Binary traces of TaskManager calls, for replay against other builds.
+//
+// A trace file is the 8-byte magic "TASKTRC1" followed by one record per
+// call: an i64 timestamp in nanoseconds since recording started, then the
+// call encoded as a task_protocol request frame. Replaying a trace is
+// therefore the same as sending its frames to a TaskServer.
+namespace task_trace
+{
+constexpr char MAGIC[8] = {'T', 'A', 'S', 'K', 'T', 'R', 'C', '1'};
+
+// Appends records to a trace file. Records are buffered and written in
+// large blocks, so calls made just before a crash may be lost.
+class Recorder
+{
+public:
+    Recorder();
+    ~Recorder();
+    Recorder(const Recorder &) = delete;
+    Recorder& operator=(const Recorder &) = delete;
+
+    bool open(const std::string &path);
+    bool close();  // false if any write failed
+
+    template <typename... Args>
+    void record(task_protocol::Opcode op, const Args &...args)
+    {
+        size_t start = beginRecord(op);
+        (put(args), ...);
+        endRecord(start);
+    }
+
+private:
+    size_t beginRecord(task_protocol::Opcode op);
+    void endRecord(size_t start);
+
+    // Argument encodings match the request layouts in task_protocol.h
+    void put(int value) { writer.i32(value); }
+    void put(long long value) { writer.i64(value); }
+    void put(bool value) { writer.u8(value ? 1 : 0); }
+    void put(Priority value) { writer.u8(static_cast<uint8_t>(value)); }
+    void put(size_t value) { writer.u32(value > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(value)); }
+    void put(const std::string &value) { writer.str(value); }
+
+    FILE *file;
+    bool failed;
+    std::string buffer;
+    task_protocol::Writer writer;
+    std::chrono::steady_clock::time_point started;
+};
+
+struct Record
+{
+    int64_t time_ns;     // offset from the start of recording
+    const char *frame;   // request frame, including its length prefix
+    size_t frame_size;
+};
+
+// Splits a whole trace held in memory into records pointing into data.
+// Returns false if the magic is missing or a record is cut short.
+bool parse(const std::string &data, std::vector<Record> &records);
+bool readFile(const std::string &path, std::string &data);
+}
+
+#endif
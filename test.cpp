@@ -1,6 +1,9 @@
 #include "task_manager.h"
+#include "task_replay.h"
+#include "task_server.h"
 #include <deepstate/DeepState.hpp>
 #include <sstream>
+#include <cstdio>
 #include <iostream>
 
 using namespace std;
@@ -469,3 +472,544 @@ TEST(TaskManagerTest, NotifyHighPriorityTasks) {
     // Restore original std::cout buffer
     std::cout.rdbuf(original_buf);
 }
+
+TEST(TaskManagerTest, TaskDependencies) {
+    TaskManager task_manager;
+
+    // Task 3 depends on tasks 1 and 2
+    task_manager.addTask("Design", "Write the design", Priority::HIGH);
+    task_manager.addTask("Review", "Review the design", Priority::MEDIUM);
+    task_manager.addTask("Build", "Build the feature", Priority::MEDIUM);
+    task_manager.addTaskDependency(3, 1);
+    task_manager.addTaskDependency(3, 2);
+
+    DeepState_Assert(task_manager.isTaskReady(1));
+    DeepState_Assert(task_manager.isTaskReady(2));
+    DeepState_Assert(!task_manager.isTaskReady(3));
+
+    // Completing prerequisites in any order releases the dependent
+    int first = DeepState_IntInRange(1, 2);
+    task_manager.markTaskCompleted(first);
+    DeepState_Assert(!task_manager.isTaskReady(3));
+    task_manager.markTaskCompleted(3 - first);
+    DeepState_Assert(task_manager.isTaskReady(3));
+    DeepState_Assert(task_manager.getReadyTasks() == std::vector<int>{3});
+
+    // Reopening a prerequisite blocks the dependent again
+    task_manager.updateTaskStatus(first, false);
+    DeepState_Assert(!task_manager.isTaskReady(3));
+
+    // Deleting the reopened prerequisite releases it
+    task_manager.deleteTask(first);
+    DeepState_Assert(task_manager.isTaskReady(3));
+}
+
+TEST(TaskManagerTest, TaskDependencyCycle) {
+    TaskManager task_manager;
+
+    task_manager.addTask("Task 1", "Test task 1", Priority::LOW);
+    task_manager.addTask("Task 2", "Test task 2", Priority::LOW);
+    task_manager.addTask("Task 3", "Test task 3", Priority::LOW);
+    task_manager.addTaskDependency(2, 1);
+    task_manager.addTaskDependency(3, 2);
+
+    std::stringstream output;
+    std::streambuf* original_buf = std::cout.rdbuf(output.rdbuf());
+
+    // Closing the chain back onto task 1 must be rejected
+    task_manager.addTaskDependency(1, 3);
+    task_manager.addTaskDependency(1, 1);
+
+    std::cout.rdbuf(original_buf);
+
+    DeepState_Assert(output.str().find("Error: Dependency would create a cycle.") != string::npos);
+    DeepState_Assert(task_manager.isTaskReady(1));
+    DeepState_Assert(!task_manager.isTaskReady(2));
+    DeepState_Assert(!task_manager.isTaskReady(3));
+}
+
+TEST(TaskManagerTest, NotifyOverdueTasks) {
+    TaskManager task_manager;
+
+    // Drive deadlines from a fake clock
+    long long now = 1000;
+    task_manager.setClock([&now]() { return now; });
+
+    task_manager.addTask("Report", "Write the report", Priority::HIGH, 1010);
+    task_manager.addTask("Slides", "Prepare slides", Priority::MEDIUM, 5000);
+    task_manager.addTask("Email", "Answer email", Priority::LOW);
+    task_manager.addTask("Budget", "Plan the budget", Priority::LOW, 1020);
+
+    // Push the slides deadline earlier and finish the budget
+    task_manager.updateTask(2, "Slides", "Prepare slides", Priority::MEDIUM, 1015);
+    task_manager.markTaskCompleted(4);
+
+    int elapsed = DeepState_IntInRange(0, 9);
+    now += elapsed;
+
+    std::stringstream output;
+    std::streambuf* original_buf = std::cout.rdbuf(output.rdbuf());
+    task_manager.notifyOverdueTasks();
+    std::cout.rdbuf(original_buf);
+    DeepState_Assert(output.str().empty());  // Nothing is due yet
+
+    now = 2000;
+    output.str("");
+    original_buf = std::cout.rdbuf(output.rdbuf());
+    task_manager.notifyOverdueTasks();
+    task_manager.notifyOverdueTasks();  // Each deadline is reported only once
+    std::cout.rdbuf(original_buf);
+
+    DeepState_Assert(output.str() == "Overdue task: Report\nOverdue task: Slides\n");
+
+    // A task completed through its pointer and then cleared is not reported
+    task_manager.addTask("Direct", "Completed in place", Priority::LOW, 2100);
+    task_manager.findTask(5)->is_completed = true;
+    task_manager.clearCompletedTasks();
+    now = 3000;
+    output.str("");
+    original_buf = std::cout.rdbuf(output.rdbuf());
+    task_manager.notifyOverdueTasks();
+    std::cout.rdbuf(original_buf);
+    DeepState_Assert(output.str().empty());
+}
+
+TEST(TaskManagerTest, AutocompleteTitle) {
+    TaskManager task_manager;
+
+    task_manager.addTask("Plan sprint", "Description 1", Priority::LOW);
+    task_manager.addTask("Planning poker", "Description 2", Priority::LOW);
+    task_manager.addTask("Pay invoices", "Description 3", Priority::LOW);
+    task_manager.addTask("plant trees", "Description 4", Priority::LOW);
+
+    // Matches come back ordered by title
+    DeepState_Assert((task_manager.autocompleteTitle("Plan", 10) == std::vector<int>{1, 2}));
+    DeepState_Assert((task_manager.autocompleteTitle("P", 10) == std::vector<int>{3, 1, 2}));
+    DeepState_Assert((task_manager.autocompleteTitle("Pla", 1) == std::vector<int>{1}));
+    DeepState_Assert(task_manager.autocompleteTitle("Planx", 10).empty());
+
+    // The index follows renames, deletes and completed-task cleanup
+    task_manager.updateTask(3, "Plan budget", "Description 3", Priority::LOW);
+    task_manager.deleteTask(2);
+    DeepState_Assert((task_manager.autocompleteTitle("Plan", 10) == std::vector<int>{3, 1}));
+    task_manager.markTaskCompleted(1);
+    task_manager.clearCompletedTasks();
+    DeepState_Assert((task_manager.autocompleteTitle("Plan", 10) == std::vector<int>{3}));
+
+    // Case-insensitive matching picks up the lower-case title
+    task_manager.setTitleMatchIgnoreCase(true);
+    DeepState_Assert((task_manager.autocompleteTitle("PLAN", 10) == std::vector<int>{3, 4}));
+
+    int task_id = DeepState_IntInRange(3, 4);
+    task_manager.deleteTask(task_id);
+    DeepState_Assert(task_manager.autocompleteTitle("plan", 10).size() == 1);
+
+    // A rename through the task pointer leaves a stale entry behind; display
+    // skips it once the task is gone
+    task_manager.addTask("apple", "Description 5", Priority::LOW);
+    task_manager.findTask(5)->title = "zzz";
+    task_manager.deleteTask(5);
+    std::stringstream output;
+    std::streambuf* original_buf = std::cout.rdbuf(output.rdbuf());
+    task_manager.displayTitleSuggestions("a", 10);
+    std::cout.rdbuf(original_buf);
+    DeepState_Assert(output.str() == "Tasks with title starting with 'a':\n");
+}
+
+TEST(TaskManagerTest, SnapshotIsolation) {
+    TaskManager task_manager;
+
+    task_manager.addTask("Task 1", "Test task 1", Priority::LOW);
+    task_manager.addTask("Task 2", "Test task 2", Priority::MEDIUM);
+    task_manager.addTask("Task 3", "Test task 3", Priority::HIGH);
+
+    TaskSnapshot snapshot = task_manager.snapshot();
+
+    // Writes after the snapshot must not be visible through it
+    int task_id = DeepState_IntInRange(1, 3);
+    task_manager.updateTask(task_id, "Renamed", "Changed", Priority::HIGH);
+    task_manager.markTaskCompleted(task_id);
+    task_manager.deleteTask(task_id % 3 + 1);
+    task_manager.addTask("Task 4", "Test task 4", Priority::LOW);
+    task_manager.sortTasksByTitle();
+
+    DeepState_Assert(snapshot.size() == 3);
+    int expected_id = 1;
+    for (const auto &task : snapshot) {
+        DeepState_Assert(task.task_id == expected_id);
+        DeepState_Assert(task.title == "Task " + std::to_string(expected_id));
+        DeepState_Assert(!task.is_completed);
+        ++expected_id;
+    }
+
+    // The live store reflects the writes
+    DeepState_Assert(task_manager.getTaskCount() == 3);
+    DeepState_Assert(task_manager.findTask(task_id)->title == "Renamed");
+    DeepState_Assert(snapshot.find(task_id)->title != "Renamed");
+}
+
+TEST(TaskManagerTest, ServerPipelinedRequests) {
+    TaskManager task_manager;
+    TaskServer server(task_manager, "/tmp/unused.sock");
+    using namespace task_protocol;
+
+    // Three requests sent back to back in one buffer
+    std::string requests;
+    Writer writer(requests);
+    size_t start = writer.beginFrame();
+    writer.u8(static_cast<uint8_t>(Opcode::ADD_TASK));
+    writer.str("Remote task");
+    writer.str("Added over the socket");
+    writer.u8(static_cast<uint8_t>(Priority::HIGH));
+    writer.i64(NO_DUE_DATE);
+    writer.endFrame(start);
+    start = writer.beginFrame();
+    writer.u8(static_cast<uint8_t>(Opcode::FIND_TASK));
+    writer.i32(1);
+    writer.endFrame(start);
+    start = writer.beginFrame();
+    writer.u8(static_cast<uint8_t>(Opcode::GET_COUNT));
+    writer.u8(0);  // Trailing garbage makes the request invalid
+    writer.endFrame(start);
+
+    // Only a prefix of the last frame has arrived so far
+    int missing = DeepState_IntInRange(1, 5);
+    std::string responses;
+    size_t consumed = server.handleRequests(requests.data(), requests.size() - missing, responses);
+    DeepState_Assert(consumed < requests.size());
+    consumed += server.handleRequests(requests.data() + consumed, requests.size() - consumed, responses);
+    DeepState_Assert(consumed == requests.size());
+
+    // Responses come back in request order
+    size_t offset = 0;
+    std::vector<Reader> frames;
+    while (size_t frame = completeFrameSize(responses.data() + offset, responses.size() - offset)) {
+        frames.emplace_back(responses.data() + offset + sizeof(uint32_t), frame - sizeof(uint32_t));
+        offset += frame;
+    }
+    DeepState_Assert(frames.size() == 3);
+
+    DeepState_Assert(frames[0].u8() == static_cast<uint8_t>(Status::OK));
+    DeepState_Assert(frames[0].str() == "Task added successfully.\n");
+
+    DeepState_Assert(frames[1].u8() == static_cast<uint8_t>(Status::OK));
+    DeepState_Assert(frames[1].str().empty());
+    DeepState_Assert(frames[1].u8() == 1);
+    Task task = frames[1].task();
+    DeepState_Assert(task.task_id == 1 && task.title == "Remote task" && task.priority == Priority::HIGH);
+
+    DeepState_Assert(frames[2].u8() == static_cast<uint8_t>(Status::BAD_REQUEST));
+
+    // With an output limit the server stops once that much is queued and
+    // leaves the remaining requests in the input
+    std::string limited;
+    consumed = server.handleRequests(requests.data(), requests.size(), limited, 1);
+    DeepState_Assert(consumed == completeFrameSize(requests.data(), requests.size()));
+    DeepState_Assert(completeFrameSize(limited.data(), limited.size()) == limited.size());
+}
+
+TEST(TaskManagerTest, ParallelImportMatchesSerial) {
+    // About 5 MB of CSV with quoted fields that span lines, so windows and
+    // parallel pieces split inside quoted text
+    std::string csv = "id,title,description,priority,completed,due_date\n";
+    int records = 40000;
+    int bad_every = DeepState_IntInRange(500, 1000);
+    for (int i = 0; i < records; ++i) {
+        csv += std::to_string(i) + ",";
+        if (i % 3 == 0)
+            csv += "\"Title " + std::to_string(i) + ", with comma\"";
+        else
+            csv += "Title " + std::to_string(i);
+        csv += ",\"Line one of " + std::to_string(i) + "\nline \"\"two\"\"\n" + std::string(i % 50, 'x') + "\",";
+        csv += i % bad_every == 0 ? "Urgent" : (i % 2 == 0 ? "High" : "low");
+        csv += i % 4 == 0 ? ",1," : ",0,";
+        csv += i % 5 == 0 ? "" : std::to_string(1700000000 + i);
+        csv += "\n";
+    }
+    DeepState_Assert(csv.size() > (2u << 20));
+
+    auto import = [&csv](const task_io::ImportOptions &options, task_io::ImportResult &result) {
+        std::vector<Task> tasks;
+        result = task_io::importBuffer(csv.data(), csv.size(), task_io::Format::CSV,
+                                       [&tasks](std::vector<Task> &batch) {
+                                           tasks.insert(tasks.end(), batch.begin(), batch.end());
+                                       },
+                                       options);
+        return tasks;
+    };
+
+    task_io::ImportOptions serial;
+    serial.threads = 1;
+    serial.block_size = csv.size();
+    task_io::ImportResult expected_result;
+    std::vector<Task> expected = import(serial, expected_result);
+    DeepState_Assert(expected_result.malformed == static_cast<size_t>((records - 1) / bad_every + 1));
+    DeepState_Assert(expected_result.records + expected_result.malformed == static_cast<size_t>(records));
+
+    // Multi-piece windows carried over block boundaries, then tiny blocks
+    // that must grow to fit a single record
+    task_io::ImportOptions parallel;
+    parallel.threads = DeepState_IntInRange(2, 8);
+    parallel.use_mmap = false;
+    size_t block_sizes[] = {3u << 20, 64};
+    for (size_t block_size : block_sizes) {
+        parallel.block_size = block_size;
+        task_io::ImportResult result;
+        std::vector<Task> tasks = import(parallel, result);
+        DeepState_Assert(result.records == expected_result.records);
+        DeepState_Assert(result.malformed == expected_result.malformed);
+        DeepState_Assert(tasks.size() == expected.size());
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            DeepState_Assert(tasks[i].title == expected[i].title);
+            DeepState_Assert(tasks[i].description == expected[i].description);
+            DeepState_Assert(tasks[i].priority == expected[i].priority);
+            DeepState_Assert(tasks[i].is_completed == expected[i].is_completed);
+            DeepState_Assert(tasks[i].due_date == expected[i].due_date);
+        }
+    }
+    DeepState_Assert(expected[0].title == "Title 1");  // record 0 is malformed
+    DeepState_Assert(expected[0].description == "Line one of 1\nline \"two\"\nx");
+}
+
+TEST(TaskManagerTest, ServerOversizedResponse) {
+    TaskManager task_manager;
+    TaskServer server(task_manager, "/tmp/unused.sock");
+    using namespace task_protocol;
+
+    // Listing 30 tasks with 50 KB titles needs more than one frame can hold
+    int tasks = DeepState_IntInRange(25, 30);
+    std::string requests;
+    Writer writer(requests);
+    for (int i = 0; i < tasks; ++i) {
+        size_t start = writer.beginFrame();
+        writer.u8(static_cast<uint8_t>(Opcode::ADD_TASK));
+        writer.str(std::string(50000, 'a' + i % 26));
+        writer.str("");
+        writer.u8(static_cast<uint8_t>(Priority::LOW));
+        writer.i64(NO_DUE_DATE);
+        writer.endFrame(start);
+    }
+    size_t start = writer.beginFrame();
+    writer.u8(static_cast<uint8_t>(Opcode::DISPLAY_ALL));
+    writer.endFrame(start);
+    start = writer.beginFrame();
+    writer.u8(static_cast<uint8_t>(Opcode::GET_COUNT));
+    writer.endFrame(start);
+
+    std::string responses;
+    DeepState_Assert(server.handleRequests(requests.data(), requests.size(), responses) == requests.size());
+
+    // Every response frame parses, and the stream continues past the large one
+    size_t offset = 0;
+    std::vector<Reader> frames;
+    while (size_t frame = completeFrameSize(responses.data() + offset, responses.size() - offset)) {
+        DeepState_Assert(frame != SIZE_MAX);
+        frames.emplace_back(responses.data() + offset + sizeof(uint32_t), frame - sizeof(uint32_t));
+        offset += frame;
+    }
+    DeepState_Assert(offset == responses.size());
+    DeepState_Assert(frames.size() == static_cast<size_t>(tasks + 2));
+
+    Reader &listing = frames[tasks];
+    DeepState_Assert(listing.u8() == static_cast<uint8_t>(Status::RESPONSE_TOO_LARGE));
+    DeepState_Assert(listing.str().empty());
+    Reader &count = frames[tasks + 1];
+    DeepState_Assert(count.u8() == static_cast<uint8_t>(Status::OK));
+    count.str();
+    DeepState_Assert(count.u32() == static_cast<uint32_t>(tasks));
+}
+
+TEST(TaskManagerTest, ImportExportTasks) {
+    TaskManager source;
+    source.addTask("Plain", "No special characters", Priority::LOW);
+    source.addTask("Comma, \"quote\"", "Line one\nline two", Priority::HIGH, 1700000000);
+    source.addTask("Tab\tand \\ backslash", "", Priority::MEDIUM);
+    source.markTaskCompleted(2);
+
+    task_io::Format format = DeepState_IntInRange(0, 1) == 0 ? task_io::Format::CSV : task_io::Format::JSONL;
+    std::string path = "/tmp/task_manager_test_export.txt";
+
+    TaskManager target;
+    target.addTask("Existing", "Already here", Priority::LOW);
+
+    std::stringstream output;
+    std::streambuf* original_buf = std::cout.rdbuf(output.rdbuf());
+    source.exportTasks(path, format);
+    target.importTasks(path, format);
+    std::cout.rdbuf(original_buf);
+    std::remove(path.c_str());
+
+    // Bulk import is silent per task and reports a summary instead
+    DeepState_Assert(output.str() == "Exported 3 tasks.\nImported 3 tasks.\n");
+    DeepState_Assert(target.getTaskCount() == 4);
+
+    // Imported tasks get fresh ids after the existing ones
+    for (int i = 1; i <= 3; ++i) {
+        Task* original = source.findTask(i);
+        Task* imported = target.findTask(i + 1);
+        DeepState_Assert(imported != nullptr);
+        DeepState_Assert(imported->title == original->title);
+        DeepState_Assert(imported->description == original->description);
+        DeepState_Assert(imported->priority == original->priority);
+        DeepState_Assert(imported->is_completed == original->is_completed);
+        DeepState_Assert(imported->due_date == original->due_date);
+    }
+    DeepState_Assert((target.autocompleteTitle("Comma", 10) == std::vector<int>{3}));
+}
+
+TEST(TaskManagerTest, SharedMemoryMirror) {
+    TaskManager task_manager;
+    task_manager.addTask("Before publish", "Copied on publish", Priority::LOW);
+    std::string name = "/task_manager_test_shared";
+    DeepState_Assert(task_manager.publishToSharedMemory(name));
+
+    SharedTaskReader reader;
+    DeepState_Assert(reader.open(name));
+    DeepState_Assert(reader.getTaskCount() == 1);
+
+    // Random mutations must show up in the segment exactly as in the manager
+    for (int step = 0; step < 40; ++step) {
+        int task_id = DeepState_IntInRange(1, task_manager.getTaskCount() + 1);
+        switch (DeepState_IntInRange(0, 4)) {
+        case 0:
+            task_manager.addTask(DeepState_CStrUpToLen(MAX_TITLE_LENGTH), DeepState_CStrUpToLen(MAX_DESC_LENGTH),
+                                 static_cast<Priority>(DeepState_IntInRange(0, 2)));
+            break;
+        case 1:
+            task_manager.deleteTask(task_id);
+            break;
+        case 2:
+            task_manager.updateTask(task_id, DeepState_CStrUpToLen(MAX_TITLE_LENGTH), DeepState_CStrUpToLen(MAX_DESC_LENGTH),
+                                    static_cast<Priority>(DeepState_IntInRange(0, 2)), DeepState_IntInRange(-1, 1000));
+            break;
+        case 3:
+            task_manager.updateTaskStatus(task_id, DeepState_IntInRange(0, 1) == 1);
+            break;
+        default:
+            task_manager.clearCompletedTasks();
+            break;
+        }
+    }
+
+    TaskSnapshot expected = task_manager.snapshot();
+    DeepState_Assert(reader.getTaskCount() == static_cast<int>(expected.size()));
+    for (const auto &task : expected) {
+        Task shared;
+        DeepState_Assert(reader.findTask(task.task_id, shared));
+        DeepState_Assert(shared.title == task.title);
+        DeepState_Assert(shared.description == task.description);
+        DeepState_Assert(shared.priority == task.priority);
+        DeepState_Assert(shared.is_completed == task.is_completed);
+        DeepState_Assert(shared.due_date == task.due_date);
+    }
+
+    task_manager.resetTasks();
+    DeepState_Assert(reader.getTaskCount() == 0);
+
+    // An update too large for the segment withdraws the stale copy
+    task_manager.addTask("Grows", "Short", Priority::LOW);
+    Task shared;
+    DeepState_Assert(reader.findTask(1, shared));
+    task_manager.updateTask(1, "Grows", std::string(1 << 20, 'x'), Priority::LOW);
+    DeepState_Assert(!reader.findTask(1, shared));
+
+    // Publishing again under the same name replaces the segment; the old
+    // mapping stays readable and a fresh reader sees the current tasks
+    task_manager.deleteTask(1);
+    task_manager.addTask("Republished", "", Priority::HIGH);
+    DeepState_Assert(reader.getTaskCount() == 1);
+    DeepState_Assert(task_manager.publishToSharedMemory(name));
+    task_manager.addTask("After", "", Priority::LOW);
+    DeepState_Assert(reader.getTaskCount() == 1);
+    SharedTaskReader fresh;
+    DeepState_Assert(fresh.open(name));
+    DeepState_Assert(fresh.getTaskCount() == task_manager.getTaskCount());
+    DeepState_Assert(fresh.findTask(2, shared) && shared.title == "Republished");
+}
+
+TEST(TaskManagerTest, TraceReplay) {
+    std::string path = "/tmp/task_manager_test_trace.bin";
+    TaskManager recorded;
+    std::stringstream output;
+    std::streambuf* original_buf = std::cout.rdbuf(output.rdbuf());
+    DeepState_Assert(recorded.startTrace(path));
+
+    std::vector<Task> batch(2);
+    batch[0].title = "Batch one";
+    batch[0].priority = Priority::LOW;
+    batch[0].is_completed = false;
+    batch[0].due_date = NO_DUE_DATE;
+    batch[1].title = "Batch two";
+    batch[1].priority = Priority::HIGH;
+    batch[1].is_completed = true;
+    batch[1].due_date = 50;
+    recorded.addTaskBatch(batch);
+
+    int calls = 0;
+    for (int step = 0; step < 60; ++step) {
+        int task_id = DeepState_IntInRange(1, recorded.getTaskCount() + 2);
+        int other_id = DeepState_IntInRange(1, recorded.getTaskCount() + 2);
+        calls += 2;  // getTaskCount above
+        switch (DeepState_IntInRange(0, 7)) {
+        case 0:
+            recorded.addTask(DeepState_CStrUpToLen(20), DeepState_CStrUpToLen(20),
+                             static_cast<Priority>(DeepState_IntInRange(0, 2)), DeepState_IntInRange(-1, 100));
+            break;
+        case 1:
+            recorded.deleteTask(task_id);
+            break;
+        case 2:
+            recorded.updateTask(task_id, DeepState_CStrUpToLen(20), DeepState_CStrUpToLen(20), Priority::MEDIUM);
+            break;
+        case 3:
+            recorded.updateTaskStatus(task_id, DeepState_IntInRange(0, 1) == 1);
+            break;
+        case 4:
+            recorded.addTaskDependency(task_id, other_id);
+            break;
+        case 5:
+            recorded.autocompleteTitle("B", 3);
+            break;
+        case 6:
+            recorded.sortTasksByTitle();
+            break;
+        default:
+            recorded.clearCompletedTasks();
+            break;
+        }
+        ++calls;
+    }
+    recorded.stopTrace();
+    std::cout.rdbuf(original_buf);
+
+    std::string data;
+    std::vector<task_trace::Record> records;
+    DeepState_Assert(task_trace::readFile(path, data));
+    DeepState_Assert(task_trace::parse(data, records));
+    std::remove(path.c_str());
+    // The batch is traced as two adds and one status change
+    DeepState_Assert(records.size() == static_cast<size_t>(calls + 3));
+
+    TaskManager replayed;
+    task_replay::Result result = task_replay::replay(records, replayed);
+    DeepState_Assert(result.operations == records.size());
+    DeepState_Assert(result.rejected == 0);
+    DeepState_Assert(result.checksum == task_replay::stateChecksum(recorded));
+    DeepState_Assert(replayed.getTaskCount() == recorded.getTaskCount());
+
+    // A truncated trace is refused rather than partly replayed
+    data.resize(data.size() - 1);
+    DeepState_Assert(!task_trace::parse(data, records));
+
+    // Ids already issued would shift every id in the replay
+    TaskManager used;
+    original_buf = std::cout.rdbuf(output.rdbuf());
+    used.addTask("Deleted", "", Priority::LOW);
+    used.deleteTask(1);
+    DeepState_Assert(!used.startTrace(path));
+    used.resetTasks();
+    DeepState_Assert(used.startTrace(path));
+    used.stopTrace();
+    std::cout.rdbuf(original_buf);
+    std::remove(path.c_str());
+}
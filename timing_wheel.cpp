@@ -0,0 +1,169 @@
+#include "timing_wheel.h"
+
+using namespace std;
+
+namespace
+{
+uint64_t rotateLeft(uint64_t value, int shift)
+{
+    shift &= 63;
+    return shift == 0 ? value : (value << shift) | (value >> (64 - shift));
+}
+
+int highestBit(uint64_t value)
+{
+    return 63 - __builtin_clzll(value);
+}
+
+int lowestBit(uint64_t value)
+{
+    return __builtin_ctzll(value);
+}
+}
+
+TimingWheel::TimingWheel(uint64_t start_time)
+{
+    reset(start_time);
+}
+
+void TimingWheel::reset(uint64_t start_time)
+{
+    entries.clear();
+    for (int level = 0; level < LEVELS; ++level)
+    {
+        for (auto &slot : slots[level])
+        {
+            slot.clear();
+        }
+        occupied[level] = 0;
+    }
+    due.clear();
+    current_time = start_time;
+}
+
+// Moves the entry out of `from` (where entry.pos points) into its bucket
+void TimingWheel::place(Entry &entry, list<int> &from)
+{
+    list<int> *target;
+    if (entry.deadline <= current_time)
+    {
+        entry.level = -1;
+        entry.slot = 0;
+        target = &due;
+    }
+    else
+    {
+        int level = highestBit(entry.deadline ^ current_time) / SLOT_BITS;
+        int slot = static_cast<int>((entry.deadline >> (level * SLOT_BITS)) & (SLOTS - 1));
+        entry.level = level;
+        entry.slot = slot;
+        occupied[level] |= uint64_t(1) << slot;
+        target = &slots[level][slot];
+    }
+    target->splice(target->end(), from, entry.pos);
+}
+
+void TimingWheel::unlink(const Entry &entry)
+{
+    if (entry.level < 0)
+    {
+        due.erase(entry.pos);
+        return;
+    }
+
+    list<int> &slot = slots[entry.level][entry.slot];
+    slot.erase(entry.pos);
+    if (slot.empty())
+    {
+        occupied[entry.level] &= ~(uint64_t(1) << entry.slot);
+    }
+}
+
+void TimingWheel::schedule(int id, uint64_t deadline)
+{
+    auto it = entries.find(id);
+    if (it != entries.end())
+    {
+        unlink(it->second);
+        entries.erase(it);
+    }
+
+    list<int> staging{id};
+    Entry &entry = entries[id];
+    entry.deadline = deadline;
+    entry.pos = staging.begin();
+    place(entry, staging);
+}
+
+bool TimingWheel::cancel(int id)
+{
+    auto it = entries.find(id);
+    if (it == entries.end())
+    {
+        return false;
+    }
+    unlink(it->second);
+    entries.erase(it);
+    return true;
+}
+
+bool TimingWheel::contains(int id) const
+{
+    return entries.count(id) != 0;
+}
+
+vector<int> TimingWheel::advance(uint64_t now)
+{
+    list<int> pending;
+    if (now > current_time)
+    {
+        // Collect every slot whose time range the clock passes over
+        for (int level = 0; level < LEVELS; ++level)
+        {
+            int shift = level * SLOT_BITS;
+            uint64_t crossed = (now >> shift) - (current_time >> shift);
+            if (crossed == 0)
+            {
+                break;
+            }
+
+            uint64_t mask = crossed >= SLOTS
+                                ? ~uint64_t(0)
+                                : rotateLeft((uint64_t(1) << crossed) - 1,
+                                             static_cast<int>((current_time >> shift) & (SLOTS - 1)) + 1);
+            mask &= occupied[level];
+            while (mask != 0)
+            {
+                int slot = lowestBit(mask);
+                mask &= mask - 1;
+                pending.splice(pending.end(), slots[level][slot]);
+                occupied[level] &= ~(uint64_t(1) << slot);
+            }
+        }
+        current_time = now;
+
+        // Expire or cascade the collected timers to a lower level
+        while (!pending.empty())
+        {
+            place(entries.at(pending.front()), pending);
+        }
+    }
+
+    vector<int> expired(due.begin(), due.end());
+    for (int id : expired)
+    {
+        entries.erase(id);
+    }
+    due.clear();
+    return expired;
+}
+
+uint64_t TimingWheel::currentTime() const
+{
+    return current_time;
+}
+
+size_t TimingWheel::size() const
+{
+    return entries.size();
+}
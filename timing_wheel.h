@@ -0,0 +1,57 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Hierarchical timing wheel keyed by task id.
+// Level L has 64 slots, each covering 64^L ticks. A timer is stored on the
+// level of the highest base-64 digit where its deadline differs from the
+// current time, and cascades down as the clock approaches it. Scheduling,
+// rescheduling and cancelling are O(1); advancing the clock costs O(expired)
+// plus a bounded number of cascades per timer.
+class TimingWheel
+{
+public:
+    explicit TimingWheel(uint64_t start_time = 0);
+
+    // Adds a timer or moves an existing one to a new deadline
+    void schedule(int id, uint64_t deadline);
+    bool cancel(int id);
+    bool contains(int id) const;
+
+    // Moves the clock forward and returns the ids whose deadline is <= now.
+    // Moving the clock backwards is a no-op.
+    std::vector<int> advance(uint64_t now);
+
+    void reset(uint64_t start_time);
+    uint64_t currentTime() const;
+    size_t size() const;
+
+private:
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr int LEVELS = (64 + SLOT_BITS - 1) / SLOT_BITS;
+
+    struct Entry
+    {
+        uint64_t deadline;
+        int level;  // -1 while waiting in the due list
+        int slot;
+        std::list<int>::iterator pos;
+    };
+
+    void place(Entry &entry, std::list<int> &from);
+    void unlink(const Entry &entry);
+
+    std::unordered_map<int, Entry> entries;
+    std::list<int> slots[LEVELS][SLOTS];
+    uint64_t occupied[LEVELS];
+    std::list<int> due;  // timers already expired but not yet reported
+    uint64_t current_time;
+};
+
+#endif
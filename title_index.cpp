@@ -0,0 +1,201 @@
+#include "title_index.h"
+
+#include <algorithm>
+#include <cctype>
+
+using namespace std;
+
+namespace
+{
+size_t commonPrefix(string_view a, string_view b)
+{
+    size_t n = min(a.size(), b.size());
+    size_t i = 0;
+    while (i < n && a[i] == b[i])
+    {
+        ++i;
+    }
+    return i;
+}
+}
+
+TitleIndex::TitleIndex(bool ignore_case) : ignore_case(ignore_case), count(0) {}
+
+string TitleIndex::normalize(string_view title) const
+{
+    string key(title);
+    if (ignore_case)
+    {
+        for (auto &c : key)
+        {
+            c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        }
+    }
+    return key;
+}
+
+// Position of the child starting with c, or where it would be inserted
+size_t TitleIndex::childIndex(const Node &node, char c)
+{
+    auto it = lower_bound(node.children.begin(), node.children.end(), c,
+                          [](const unique_ptr<Node> &child, char value) {
+                              return static_cast<unsigned char>(child->label[0]) < static_cast<unsigned char>(value);
+                          });
+    return static_cast<size_t>(it - node.children.begin());
+}
+
+void TitleIndex::insert(string_view title, int id)
+{
+    string key = normalize(title);
+    string_view rest(key);
+    Node *node = &root;
+
+    while (!rest.empty())
+    {
+        size_t pos = childIndex(*node, rest[0]);
+        if (pos == node->children.size() || node->children[pos]->label[0] != rest[0])
+        {
+            auto leaf = make_unique<Node>();
+            leaf->label = string(rest);
+            node->children.insert(node->children.begin() + pos, move(leaf));
+            node = node->children[pos].get();
+            rest = string_view();
+            break;
+        }
+
+        Node *child = node->children[pos].get();
+        size_t shared = commonPrefix(rest, child->label);
+        if (shared < child->label.size())
+        {
+            // Split the edge so the shared part becomes its own node
+            auto middle = make_unique<Node>();
+            middle->label = child->label.substr(0, shared);
+            child->label.erase(0, shared);
+            middle->children.push_back(move(node->children[pos]));
+            node->children[pos] = move(middle);
+            child = node->children[pos].get();
+        }
+        node = child;
+        rest.remove_prefix(shared);
+    }
+
+    node->ids.push_back(id);
+    ++count;
+}
+
+bool TitleIndex::eraseFrom(Node &node, string_view key, int id)
+{
+    if (key.empty())
+    {
+        auto it = find(node.ids.begin(), node.ids.end(), id);
+        if (it == node.ids.end())
+        {
+            return false;
+        }
+        node.ids.erase(it);
+        return true;
+    }
+
+    size_t pos = childIndex(node, key[0]);
+    if (pos == node.children.size())
+    {
+        return false;
+    }
+    Node &child = *node.children[pos];
+    if (key.compare(0, child.label.size(), child.label) != 0)
+    {
+        return false;
+    }
+    if (!eraseFrom(child, key.substr(child.label.size()), id))
+    {
+        return false;
+    }
+
+    // Drop empty leaves and merge pass-through nodes to keep the trie compact
+    if (child.ids.empty() && child.children.empty())
+    {
+        node.children.erase(node.children.begin() + pos);
+    }
+    else if (child.ids.empty() && child.children.size() == 1)
+    {
+        unique_ptr<Node> grandchild = move(child.children[0]);
+        grandchild->label.insert(0, child.label);
+        node.children[pos] = move(grandchild);
+    }
+    return true;
+}
+
+bool TitleIndex::erase(string_view title, int id)
+{
+    if (!eraseFrom(root, normalize(title), id))
+    {
+        return false;
+    }
+    --count;
+    return true;
+}
+
+void TitleIndex::clear()
+{
+    root.ids.clear();
+    root.children.clear();
+    count = 0;
+}
+
+void TitleIndex::collect(const Node &node, size_t limit, vector<int> &out)
+{
+    for (int id : node.ids)
+    {
+        if (out.size() >= limit)
+        {
+            return;
+        }
+        out.push_back(id);
+    }
+    for (const auto &child : node.children)
+    {
+        if (out.size() >= limit)
+        {
+            return;
+        }
+        collect(*child, limit, out);
+    }
+}
+
+vector<int> TitleIndex::findPrefix(string_view prefix, size_t limit) const
+{
+    vector<int> result;
+    string key = normalize(prefix);
+    string_view rest(key);
+    const Node *node = &root;
+
+    while (!rest.empty())
+    {
+        size_t pos = childIndex(*node, rest[0]);
+        if (pos == node->children.size())
+        {
+            return result;
+        }
+        const Node *child = node->children[pos].get();
+        size_t shared = commonPrefix(rest, child->label);
+        if (shared == 0 || (shared < rest.size() && shared < child->label.size()))
+        {
+            return result;
+        }
+        node = child;
+        rest.remove_prefix(shared);
+    }
+
+    collect(*node, limit, result);
+    return result;
+}
+
+bool TitleIndex::ignoresCase() const
+{
+    return ignore_case;
+}
+
+size_t TitleIndex::size() const
+{
+    return count;
+}
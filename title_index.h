@@ -0,0 +1,47 @@
+#ifndef TITLE_INDEX_H
+#define TITLE_INDEX_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Radix trie over task titles for prefix (type-ahead) queries.
+// Every node either ends at least one title or has two or more children, so
+// collecting K matches below the prefix node visits O(K) nodes. Matches come
+// back ordered by title, then by insertion order for equal titles.
+class TitleIndex
+{
+public:
+    explicit TitleIndex(bool ignore_case = false);
+
+    void insert(std::string_view title, int id);
+    bool erase(std::string_view title, int id);
+    void clear();
+
+    // Returns up to limit ids whose title starts with prefix
+    std::vector<int> findPrefix(std::string_view prefix, size_t limit) const;
+
+    bool ignoresCase() const;
+    size_t size() const;
+
+private:
+    struct Node
+    {
+        std::string label;  // edge label leading into this node
+        std::vector<int> ids;  // titles ending exactly here
+        std::vector<std::unique_ptr<Node>> children;  // sorted by label[0]
+    };
+
+    std::string normalize(std::string_view title) const;
+    static size_t childIndex(const Node &node, char c);
+    static bool eraseFrom(Node &node, std::string_view key, int id);
+    static void collect(const Node &node, size_t limit, std::vector<int> &out);
+
+    Node root;
+    bool ignore_case;
+    size_t count;
+};
+
+#endif